@@ -0,0 +1,84 @@
+#ifndef COMPONENT_SETS_HPP
+#define COMPONENT_SETS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <entt/entt.hpp>
+
+#include "components/base.hpp"
+#include "components/physics.hpp"
+#include "components/render.hpp"
+
+// INFO: The component sets walked every tick live in entt groups, so their pools stay packed in
+// the same order and iteration never probes the sparse arrays. Build with ASTEROIDS_USE_GROUPS=0
+// to fall back to plain views, benchmarks/iteration_benchmark.cpp compares both.
+//
+// Ownership, a component can only be owned by one group:
+//   transform + physics                       owning group, shared by physics and boundary
+//   circle_collider + collision_filter        partial group, reads transform
+//   sprite_render                             partial group, reads transform
+#ifndef ASTEROIDS_USE_GROUPS
+#define ASTEROIDS_USE_GROUPS 1
+#endif
+
+// INFO: Walks the transform + physics bodies as runs of plain arrays, transforms[i] belongs to the
+// same entity as bodies[i]. With groups the runs are whole storage pages, otherwise single bodies.
+template<typename Func>
+void each_body_page(entt::registry& registry, Func func)
+{
+#if ASTEROIDS_USE_GROUPS
+    auto physics_group = registry.group<transform, physics>();
+
+    static_assert(entt::component_traits<transform>::page_size == entt::component_traits<physics>::page_size);
+    constexpr std::size_t page_size = entt::component_traits<transform>::page_size;
+
+    auto transform_pages = physics_group.template storage<transform>()->raw();
+    auto physics_pages   = physics_group.template storage<physics>()->raw();
+
+    for (std::size_t first = 0, page = 0; first < physics_group.size(); first += page_size, page++)
+    {
+        func(transform_pages[page], physics_pages[page], std::min(page_size, physics_group.size() - first));
+    }
+#else
+    for (auto [entity, transform_data, physics_data] : registry.view<transform, physics>().each())
+    {
+        func(&transform_data, &physics_data, 1);
+    }
+#endif
+}
+
+// INFO: func(entity, transform&, circle_collider&, collision_filter&)
+template<typename Func>
+void each_collider(entt::registry& registry, Func func)
+{
+#if ASTEROIDS_USE_GROUPS
+    for (auto [entity, collision_data, filter_data, transform_data] : registry.group<circle_collider, collision_filter>(entt::get<transform>).each())
+    {
+        func(entity, transform_data, collision_data, filter_data);
+    }
+#else
+    for (auto [entity, transform_data, collision_data, filter_data] : registry.view<transform, circle_collider, collision_filter>().each())
+    {
+        func(entity, transform_data, collision_data, filter_data);
+    }
+#endif
+}
+
+// INFO: func(entity, transform&, sprite_render&)
+template<typename Func>
+void each_sprite(entt::registry& registry, Func func)
+{
+#if ASTEROIDS_USE_GROUPS
+    for (auto [entity, render_data, transform_data] : registry.group<sprite_render>(entt::get<transform>).each())
+    {
+        func(entity, transform_data, render_data);
+    }
+#else
+    for (auto [entity, transform_data, render_data] : registry.view<transform, sprite_render>().each())
+    {
+        func(entity, transform_data, render_data);
+    }
+#endif
+}
+
+#endif // COMPONENT_SETS_HPP
@@ -4,6 +4,7 @@
 #include <raylib.h>
 #include <stdint.h>
 
+#include <cstddef>
 #include <entt/entt.hpp>
 
 struct asteroid
@@ -14,9 +15,27 @@ struct asteroid
     entt::delegate<void(entt::registry&, entt::entity, Vector2, int)> on_asteroid_death;
 };
 
+struct star_spawn
+{
+    Vector2 position;
+    float angle;
+};
+
+struct asteroid_spawn
+{
+    Vector2 position;
+    Vector2 velocity;
+    int8_t level;
+};
+
 entt::entity spawn_star(entt::registry& registry, Vector2 position, float angle);
 entt::entity spawn_asteroid(entt::registry& registry, Vector2 position, Vector2 velocity, int8_t level);
 
+// INFO: Bulk versions, texture lookups and shared components are resolved once per call and every
+// component is filled with one range insert. created, when given, receives one entity per spawn.
+void spawn_stars(entt::registry& registry, const star_spawn* spawns, std::size_t count, entt::entity* created = nullptr);
+void spawn_asteroids(entt::registry& registry, const asteroid_spawn* spawns, std::size_t count, entt::entity* created = nullptr);
+
 entt::entity spawn_smoke_explosion(entt::registry& registry, Vector2 position, int id, float radius, float duration);
 void spawn_random_asteroid_distribution(entt::registry& registry, int count);
 void spawn_random_start_distribution(entt::registry& registry, int count);
@@ -15,27 +15,36 @@ struct transform
     float rotation;
 };
 
+// INFO: Transform as of the start of the current tick, the renderer blends it with transform
+// when frames land between two fixed ticks.
+struct previous_transform
+{
+    Vector2 position;
+    float rotation;
+};
+
 struct physics
 {
     Vector2 velocity;
     float angular_velocity;
 
+    // INFO: Fraction of the velocity lost every 1/60th of a second, applied as exponential decay
     float drag;
 
     Vector2 external_force;
     Vector2 external_impulse;
 };
 
+// INFO: The entity is destroyed lifetime seconds after the component is emplaced or replaced,
+// the timer_queue schedules it through the lifetime signals
 struct lifetime
 {
     float lifetime;
-    float elapsed;
 
-    std::function<void(entt::registry&)> on_end = nullptr;
+    // INFO: Tick the timer_queue destroys the entity on, filled in when it is scheduled
+    std::uint64_t expiry_tick = 0;
 };
 
-static const std::uint32_t kill_tag = "KILL"_hs;
-
 enum struct team
 {
     PLAYER,
@@ -3,17 +3,61 @@
 
 #include <raylib.h>
 
+#include <components/base.hpp>
+#include <components/player.hpp>
 #include <entt/entt.hpp>
-#include <memory>
-#include <utils/state.hpp>
+#include <utils/static_state_machine.hpp>
+#include <vector>
 
 using entt::operator""_hs;
 
-struct enemy_ai
+// INFO: Enemies attack once the player is closer than attack_radius and chase it otherwise
+static const float enemy_attack_radius   = 200.0f;
+static const float enemy_attack_interval = 0.65f;
+static const float enemy_chase_impulse   = 120.0f;
+static const float enemy_bullet_speed    = 360.0f;
+
+// INFO: What the behaviour of one enemy sees and acts on during a tick
+struct enemy_ai_context
 {
-    std::shared_ptr<state_machine> ai_machine;
+    Vector2 target;
+
+    transform& transform_data;
+    physics& physics_data;
+
+    // INFO: Bullets fired this tick, spawned once every enemy has acted
+    std::vector<bullet_spawn>& shots;
 };
 
+struct enemy_chasing
+{
+    void update(enemy_ai_context& context, float delta_time);
+};
+
+struct enemy_attacking
+{
+    // INFO: Seconds since the last shot, starts over every time the enemy starts attacking
+    float elapsed = 0;
+
+    void update(enemy_ai_context& context, float delta_time);
+};
+
+struct player_in_range
+{
+    bool operator()(enemy_ai_context& context) const;
+};
+
+struct player_out_of_range
+{
+    bool operator()(enemy_ai_context& context) const { return !player_in_range{}(context); }
+};
+
+// INFO: A few bytes per enemy, updated in one pass by enemy_ai_process
+using enemy_ai = static_state_machine<enemy_ai_context,
+                                      state_list<enemy_chasing, enemy_attacking>,
+                                      transition_list<transition<enemy_chasing, enemy_attacking, player_in_range>,
+                                                      transition<enemy_attacking, enemy_chasing, player_out_of_range>>>;
+
 static const std::uint32_t enemy_tag = "ENEMY"_hs;
 
 void spawn_random_enemy(entt::registry& registry);
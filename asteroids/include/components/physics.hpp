@@ -1,12 +1,77 @@
 #ifndef PHYSICS_HPP
 #define PHYSICS_HPP
 
+#include <cstdint>
 #include <entt/entt.hpp>
 
+#include "components/base.hpp"
+
+enum class collider_role : std::uint8_t
+{
+    SHIP,
+    BULLET,
+    ASTEROID,
+};
+
+// INFO: A pair is only tested when one side's layer is in the other side's mask
+struct collision_filter
+{
+    std::uint32_t layer;
+    std::uint32_t mask;
+};
+
+inline static bool collision_filter_accepts(const collision_filter& filter, const collision_filter& other_filter)
+{
+    return (filter.layer & other_filter.mask) != 0 || (other_filter.layer & filter.mask) != 0;
+}
+
+inline static std::uint32_t collision_layer_bit(team collider_team, collider_role role)
+{
+    return 1u << (static_cast<std::uint32_t>(collider_team) * 3 + static_cast<std::uint32_t>(role));
+}
+
+// NOTE: Mirrors the responders, ships get hit by asteroids and bullets, bullets break asteroids,
+// and nothing ever collides with its own team.
+inline static collision_filter make_collision_filter(team collider_team, collider_role role)
+{
+    static const team teams[]          = {team::PLAYER, team::ENEMY};
+    static const collider_role roles[] = {collider_role::SHIP, collider_role::BULLET, collider_role::ASTEROID};
+    static const bool interacts[3][3]  = {
+        // SHIP, BULLET, ASTEROID
+        {false, true, true},  // SHIP
+        {true, false, true},  // BULLET
+        {true, true, false},  // ASTEROID
+    };
+
+    collision_filter filter;
+    filter.layer = collision_layer_bit(collider_team, role);
+    filter.mask  = 0;
+
+    for (auto other_team : teams)
+    {
+        if (other_team == collider_team)
+            continue;
+
+        for (auto other_role : roles)
+        {
+            if (interacts[static_cast<int>(role)][static_cast<int>(other_role)])
+            {
+                filter.mask |= collision_layer_bit(other_team, other_role);
+            }
+        }
+    }
+
+    return filter;
+}
+
 struct circle_collider
 {
     float radius;
 
+    // INFO: Sweeps the collider along its velocity instead of testing the end position only,
+    // meant for small and fast colliders that would otherwise tunnel through thin targets.
+    bool continuous = false;
+
     entt::delegate<void(entt::registry&, entt::entity, entt::entity)> on_collision;
 };
 
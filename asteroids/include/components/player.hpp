@@ -4,6 +4,7 @@
 #include <raylib.h>
 #include <raymath.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <entt/entt.hpp>
 
@@ -25,10 +26,27 @@ static const std::uint32_t player_trail_tag = "PLAYER_TRAIL"_hs;
 
 entt::entity create_player(entt::registry& registry, uint8_t id);
 
+struct bullet_spawn
+{
+    Vector2 position;
+    Vector2 velocity;
+    team bullet_team;
+};
+
+struct explosion_spawn
+{
+    Vector2 position;
+    float scale;
+};
+
 entt::entity spawn_bullet(entt::registry& registry, Vector2 position, Vector2 velocity, const team& bullet_team);
 
 entt::entity spawn_explosion(entt::registry& registry, Vector2 position, float scale);
 
+// INFO: Bulk versions, see spawn_asteroids
+void spawn_bullets(entt::registry& registry, const bullet_spawn* spawns, std::size_t count, entt::entity* created = nullptr);
+void spawn_explosions(entt::registry& registry, const explosion_spawn* spawns, std::size_t count, entt::entity* created = nullptr);
+
 void spawn_game_ui(entt::registry& registry);
 
 void spawn_game_over(entt::registry& registry);
@@ -5,6 +5,7 @@
 #include <entt/entt.hpp>
 
 #include "base.hpp"
+#include "platform/platform.hpp"
 #include "raylib.h"
 
 enum class render_shape_type
@@ -80,19 +81,6 @@ static entt::entity LoadFontToEntity(const char* path, entt::registry& registry)
     return entity;
 }
 
-template<const GAME_TEXTURES val>
-static entt::entity LoadTextureToEntity(const char* path, entt::registry& registry)
-{
-    Texture2D texture = LoadTexture(path);
-
-    entt::entity entity = registry.create();
-
-    registry.emplace<Texture2D>(entity, texture);
-    registry.emplace<entt::tag<static_cast<std::uint32_t>(val)>>(entity);
-
-    return entity;
-}
-
 static std::vector<Vector2>* original_triangle = nullptr;
 inline static void add_render_data(entt::registry& registry, entt::entity entity, Color color)
 {
@@ -120,12 +108,12 @@ inline static void spawn_main_camera(entt::registry& registry)
 {
     entt::entity entity = registry.create();
 
-    int screenWidth  = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+    int screenWidth  = get_platform().screen_width();
+    int screenHeight = get_platform().screen_height();
 
     Camera2D camera;
     camera.target   = Vector2{screenWidth * 0.5f, screenHeight * 0.5f};
-    camera.offset   = {static_cast<float>(GetScreenWidth() / 2), static_cast<float>(GetScreenHeight() / 2)};
+    camera.offset   = {static_cast<float>(get_platform().screen_width() / 2), static_cast<float>(get_platform().screen_height() / 2)};
     camera.rotation = 0.0f;
     camera.zoom     = 1.0f;
 
@@ -0,0 +1,27 @@
+#ifndef INTEGRATOR_HPP
+#define INTEGRATOR_HPP
+
+#include <cstddef>
+
+#include "components/base.hpp"
+
+enum class physics_integrator
+{
+    SEMI_IMPLICIT_EULER,
+    VERLET,
+};
+
+// INFO: Drag is tuned per frame at this rate and rescaled to the actual step
+static const float drag_reference_rate = 60.0f;
+
+// INFO: Velocity scale for one step of delta_time, equal to (1 - drag) when stepping at drag_reference_rate
+float drag_decay(float drag, float delta_time);
+
+// INFO: Integrates count bodies stored side by side, transforms[i] belongs to the same entity as
+// bodies[i]. Uses SSE to step four bodies per instruction when available.
+void integrate_bodies(transform* transforms, physics* bodies, std::size_t count, float delta_time, physics_integrator integrator = physics_integrator::SEMI_IMPLICIT_EULER);
+
+// INFO: Reference path, integrate_bodies gives bit identical results
+void integrate_bodies_scalar(transform* transforms, physics* bodies, std::size_t count, float delta_time, physics_integrator integrator = physics_integrator::SEMI_IMPLICIT_EULER);
+
+#endif // INTEGRATOR_HPP
@@ -0,0 +1,71 @@
+#ifndef NULL_PLATFORM_HPP
+#define NULL_PLATFORM_HPP
+
+#include <array>
+#include <cstdint>
+#include <platform/platform.hpp>
+
+// INFO: Headless platform, no window, no GPU and no real input. Frames advance as fast as the
+// simulation runs with a fixed frame time, textures are empty handles and nothing is drawn.
+// Input is scripted, keys and buttons stay down until released and presses last one frame.
+class null_platform : public platform {
+   public:
+    null_platform(int width = 900, int height = 600, float frame_time = 1.0f / 60.0f, std::uint64_t frame_limit = 0);
+
+    // INFO: Advances to the next frame, closes once frame_limit frames ran (0 runs forever)
+    bool should_close() override;
+    float frame_time() const override { return _frame_time; }
+
+    int screen_width() const override { return _width; }
+    int screen_height() const override { return _height; }
+
+    int random_value(int min, int max) override;
+    void set_random_seed(unsigned int seed) override;
+
+    Texture2D load_texture(const char* path) override;
+    void unload_texture(Texture2D texture) override {}
+
+    Image decode_image(const char* path) override { return Image{nullptr, 0, 0, 0, 0}; }
+    Texture2D upload_texture(Image image) override { return load_texture(nullptr); }
+    void unload_image(Image image) override {}
+    Texture2D upload_pixels(const void* pixels, int width, int height) override { return load_texture(nullptr); }
+
+    bool is_key_down(int key) const override;
+    bool is_key_pressed(int key) const override;
+    bool is_mouse_button_down(int button) const override;
+    Vector2 mouse_position() const override { return _mouse_position; }
+
+    bool begin_drawing() override { return false; }
+    void end_drawing() override {}
+
+    // INFO: Scripted input
+    void set_key_down(int key, bool down);
+    // NOTE: Seen as pressed during the next frame only
+    void press_key(int key);
+    void set_mouse_button_down(int button, bool down);
+    void set_mouse_position(Vector2 position) { _mouse_position = position; }
+
+    std::uint64_t frame() const { return _frame; }
+
+   protected:
+    static const int key_count          = 512;
+    static const int mouse_button_count = 8;
+
+    int _width;
+    int _height;
+    float _frame_time;
+
+    std::uint64_t _frame       = 0;
+    std::uint64_t _frame_limit = 0;
+
+    std::uint32_t _random_state = 0;
+
+    std::array<bool, key_count> _keys_down             = {};
+    std::array<bool, key_count> _keys_pressed          = {};
+    std::array<bool, key_count> _keys_pending          = {};
+    std::array<bool, mouse_button_count> _buttons_down = {};
+
+    Vector2 _mouse_position = {0, 0};
+};
+
+#endif // NULL_PLATFORM_HPP
@@ -0,0 +1,53 @@
+#ifndef PLATFORM_HPP
+#define PLATFORM_HPP
+
+#include <raylib.h>
+
+// INFO: Everything the simulation needs from the outside world. Gameplay code goes through
+// get_platform() instead of calling raylib for the window, RNG, textures or input, so the same
+// scenes run on top of a real window or headless. Raylib's plain types and math stay in use.
+class platform {
+   public:
+    virtual ~platform() = default;
+
+    // INFO: Frame loop
+    virtual bool should_close() = 0;
+    virtual float frame_time() const = 0;
+
+    // INFO: Screen
+    virtual int screen_width() const = 0;
+    virtual int screen_height() const = 0;
+
+    // INFO: Random numbers, both ends of the range are inclusive
+    virtual int random_value(int min, int max) = 0;
+    virtual void set_random_seed(unsigned int seed) = 0;
+
+    // INFO: Textures
+    virtual Texture2D load_texture(const char* path) = 0;
+    virtual void unload_texture(Texture2D texture) = 0;
+
+    // INFO: Texture loading split in two. Decoding only touches the CPU and may run on any
+    // thread, uploading takes ownership of the image and has to run on the main thread.
+    virtual Image decode_image(const char* path) = 0;
+    virtual Texture2D upload_texture(Image image) = 0;
+    virtual void unload_image(Image image) = 0;
+    // INFO: Uploads RGBA8 pixels the caller keeps owning, like a mapped asset archive
+    virtual Texture2D upload_pixels(const void* pixels, int width, int height) = 0;
+
+    // INFO: Input
+    virtual bool is_key_down(int key) const = 0;
+    virtual bool is_key_pressed(int key) const = 0;
+    virtual bool is_mouse_button_down(int button) const = 0;
+    virtual Vector2 mouse_position() const = 0;
+
+    // INFO: Returns false when nothing gets presented, the render pass is skipped then and
+    // end_drawing must not be called.
+    virtual bool begin_drawing() = 0;
+    virtual void end_drawing() = 0;
+};
+
+// INFO: The platform the game runs on, set once at startup before any scene is created
+platform& get_platform();
+void set_platform(platform* instance);
+
+#endif // PLATFORM_HPP
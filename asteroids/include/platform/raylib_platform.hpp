@@ -0,0 +1,43 @@
+#ifndef RAYLIB_PLATFORM_HPP
+#define RAYLIB_PLATFORM_HPP
+
+#include <platform/platform.hpp>
+
+// INFO: Window, input and GPU textures through raylib. Opens the window on construction and
+// closes it on destruction, so textures have to be unloaded before it goes away. A target_fps of
+// 0 leaves the frame rate uncapped, config_flags are raylib's ConfigFlags (FLAG_VSYNC_HINT, ...).
+class raylib_platform : public platform {
+   public:
+    raylib_platform(int width, int height, const char* title, int target_fps = 60, unsigned int config_flags = 0);
+    ~raylib_platform() override;
+
+    raylib_platform(const raylib_platform&)            = delete;
+    raylib_platform& operator=(const raylib_platform&) = delete;
+
+    bool should_close() override;
+    float frame_time() const override;
+
+    int screen_width() const override;
+    int screen_height() const override;
+
+    int random_value(int min, int max) override;
+    void set_random_seed(unsigned int seed) override;
+
+    Texture2D load_texture(const char* path) override;
+    void unload_texture(Texture2D texture) override;
+
+    Image decode_image(const char* path) override;
+    Texture2D upload_texture(Image image) override;
+    void unload_image(Image image) override;
+    Texture2D upload_pixels(const void* pixels, int width, int height) override;
+
+    bool is_key_down(int key) const override;
+    bool is_key_pressed(int key) const override;
+    bool is_mouse_button_down(int button) const override;
+    Vector2 mouse_position() const override;
+
+    bool begin_drawing() override;
+    void end_drawing() override;
+};
+
+#endif // RAYLIB_PLATFORM_HPP
@@ -6,9 +6,9 @@
 #include <entt/entt.hpp>
 
 
-struct asteroid_spawn_process : entt::process<asteroid_spawn_process, std::uint32_t>
+struct asteroid_spawn_process : entt::process<asteroid_spawn_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     asteroid_spawn_process(entt::registry& registry) :
         registry(registry) {}
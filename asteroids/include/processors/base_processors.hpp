@@ -5,121 +5,143 @@
 
 #include <entt/entt.hpp>
 
+#include "component_sets.hpp"
 #include "components/base.hpp"
 #include "components/player.hpp"
+#include "utils/destruction_buffer.hpp"
+#include "utils/playfield.hpp"
+#include "utils/process_profiler.hpp"
+#include "utils/timer_queue.hpp"
 
-struct cleanup_process : entt::process<cleanup_process, std::uint32_t>
+struct cleanup_process : entt::process<cleanup_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     cleanup_process(entt::registry& registry) :
         registry(registry) {}
 
     void update(delta_type delta_time, void*)
     {
-        auto cleanup_view = registry.view<entt::tag<kill_tag>>();
+        destruction_buffer& buffer = destruction_buffer::of(registry);
 
-        for (auto [entity] : cleanup_view.each())
-        {
-            if (!registry.valid(entity))
-                continue;
+        profile_entities(buffer.size());
 
-            registry.destroy(entity);
-        }
+        buffer.flush(registry);
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct lifetime_process : entt::process<lifetime_process, std::uint32_t>
+// INFO: Every transform gets a previous_transform next to it, seeded with the spawn position so
+// entities created in the middle of a tick do not blend in from the origin.
+inline static void attach_previous_transform(entt::registry& registry, entt::entity entity)
 {
-    using delta_type = std::uint32_t;
+    const auto& transform_data = registry.get<transform>(entity);
+    registry.emplace<previous_transform>(entity, previous_transform{transform_data.position, transform_data.rotation});
+}
 
-    lifetime_process(entt::registry& registry) :
-        registry(registry) {}
+// NOTE: Has to be the first process of the tick, the renderer blends from this snapshot
+// towards whatever the rest of the tick produced.
+struct interpolation_snapshot_process : entt::process<interpolation_snapshot_process, float>
+{
+    using delta_type = float;
+
+    interpolation_snapshot_process(entt::registry& registry) :
+        registry(registry)
+    {
+        registry.on_construct<transform>().connect<&attach_previous_transform>();
+    }
 
     void update(delta_type delta_time, void*)
     {
-        auto lifetime_view = registry.view<lifetime>();
+        auto snapshot_view = registry.view<transform, previous_transform>();
 
-        for (auto [entity, lifetime_data] : lifetime_view.each())
+        std::size_t visited = 0;
+
+        for (auto [entity, transform_data, previous_data] : snapshot_view.each())
         {
-            if (lifetime_data.elapsed >= lifetime_data.lifetime)
-            {
-                if (lifetime_data.on_end != nullptr)
-                {
-                    lifetime_data.on_end(registry);
-                }
+            previous_data.position = transform_data.position;
+            previous_data.rotation = transform_data.rotation;
+            visited++;
+        }
 
-                registry.emplace<entt::tag<kill_tag>>(entity);
-                continue;
-            }
+        profile_entities(visited);
+    }
 
-            lifetime_data.elapsed += delta_time / 1000.0f;
-        }
+   protected:
+    entt::registry& registry;
+};
+
+struct lifetime_process : entt::process<lifetime_process, float>
+{
+    using delta_type = float;
+
+    lifetime_process(entt::registry& registry) :
+        registry(registry)
+    {
+        registry.on_construct<lifetime>().connect<&schedule_lifetime>();
+        registry.on_update<lifetime>().connect<&schedule_lifetime>();
+    }
+
+    // INFO: Only the timers due this tick are visited, live lifetimes cost nothing
+    void update(delta_type delta_time, void*)
+    {
+        profile_entities(timer_queue::of(registry).advance(registry, delta_time));
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct boundary_process : entt::process<boundary_process, std::uint32_t>
+// INFO: Branchless so the loop vectorizes, bodies never cross more than one period per tick
+inline static float wrap_coordinate(float value, float min, float max, float size)
 {
-    using delta_type = std::uint32_t;
+    return value + size * (static_cast<float>(value < min) - static_cast<float>(value >= max));
+}
+
+struct boundary_process : entt::process<boundary_process, float>
+{
+    using delta_type = float;
 
     boundary_process(entt::registry& registry) :
         registry(registry) {}
 
+    // NOTE: Only bodies can move, anything without physics (stars, text) is never visited
     void update(delta_type delta_time, void*)
     {
-        const int border_width = 50;
+        auto camera_view = registry.view<Camera2D>();
 
-        auto boundable_view = registry.view<transform>();
-        auto camera_view    = registry.view<Camera2D>();
+        if (camera_view.empty())
+            return;
 
-        auto camera_entity = camera_view.front();
-        auto camera_data   = camera_view.get<Camera2D>(camera_entity);
+        const playfield field = make_playfield(camera_view.get<Camera2D>(camera_view.front()));
+        const Vector2 min     = field.min;
+        const Vector2 max     = Vector2{field.min.x + field.size.x, field.min.y + field.size.y};
+        const Vector2 size    = field.size;
 
-        for (auto [entity, transform_data] : boundable_view.each())
-        {
-            auto screen_position = GetWorldToScreen2D(transform_data.position, camera_data);
-            bool has_changed     = false;
+        std::size_t visited = 0;
 
-            if (screen_position.x <= 0 - border_width)
-            {
-                screen_position.x = GetScreenWidth() + border_width;
-                has_changed       = true;
-            } else if (screen_position.x >= GetScreenWidth() + border_width)
+        each_body_page(registry, [min, max, size, &visited](transform* transforms, physics*, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++)
             {
-                screen_position.x = 0 - border_width;
-                has_changed       = true;
+                transforms[i].position.x = wrap_coordinate(transforms[i].position.x, min.x, max.x, size.x);
+                transforms[i].position.y = wrap_coordinate(transforms[i].position.y, min.y, max.y, size.y);
             }
 
-            if (screen_position.y <= 0 - border_width)
-            {
-                screen_position.y = GetScreenHeight() + border_width;
-                has_changed       = true;
-            } else if (screen_position.y >= GetScreenHeight() + border_width)
-            {
-                screen_position.y = 0 - border_width;
-                has_changed       = true;
-            }
+            visited += count;
+        });
 
-            if (has_changed)
-            {
-                transform_data.position = GetScreenToWorld2D(screen_position, camera_data);
-            }
-        }
+        profile_entities(visited);
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct trail_update_process : entt::process<trail_update_process, std::uint32_t>
+struct trail_update_process : entt::process<trail_update_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     trail_update_process(entt::registry& registry) :
         registry(registry) {}
@@ -140,6 +162,8 @@ struct trail_update_process : entt::process<trail_update_process, std::uint32_t>
 
         trail_transform_data.position = player_transform_data.position;
         trail_transform_data.rotation = player_transform_data.rotation;
+
+        profile_entities(2);
     }
 
    protected:
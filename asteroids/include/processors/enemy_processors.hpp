@@ -3,28 +3,58 @@
 
 #include <raylib.h>
 
+#include <components/base.hpp>
 #include <components/enemy.hpp>
+#include <components/player.hpp>
 #include <entt/entt.hpp>
+#include <utils/process_profiler.hpp>
+#include <vector>
 
-struct enemy_ai_process : entt::process<enemy_ai_process, std::uint32_t>
+// INFO: Drives every enemy in one pass. Each one acts on its current behaviour, then switches
+// to attacking when the player is in range and back to chasing when it is not.
+struct enemy_ai_process : entt::process<enemy_ai_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     enemy_ai_process(entt::registry& registry) :
         registry(registry) {}
 
     void update(delta_type delta_time, void*)
     {
-        auto delta = static_cast<float>(delta_time) / 1000.0f;
+        auto enemy_view = registry.view<enemy_ai, transform, physics>();
 
-        auto view = registry.view<enemy_ai>();
-        for (auto [entity, ai_data] : view.each())
+        profile_entities(enemy_view.size_hint());
+
+        auto player_view                 = registry.view<entt::tag<player_tag>, transform>();
+        const entt::entity player_entity = player_view.front();
+
+        // INFO: Without a player there is nothing to chase or attack
+        if (player_entity == entt::null)
+            return;
+
+        const Vector2 target = player_view.get<transform>(player_entity).position;
+
+        shots.clear();
+
+        for (auto [entity, ai_data, transform_data, physics_data] : enemy_view.each())
         {
-            ai_data.ai_machine->update(delta);
+            enemy_ai_context context = {target, transform_data, physics_data, shots};
+            ai_data.update(context, delta_time);
+        }
+
+        // NOTE: Spawned after the pass, bullets inserted into the transform pool mid iteration
+        // would shuffle it under the view
+        if (!shots.empty())
+        {
+            spawn_bullets(registry, shots.data(), shots.size());
         }
     }
 
+   protected:
     entt::registry& registry;
+
+    // INFO: Bullets fired this tick, kept between ticks so firing does not allocate
+    std::vector<bullet_spawn> shots;
 };
 
 #endif // ENEMY_PROCESSORS_HPP
@@ -4,78 +4,336 @@
 #include <raylib.h>
 #include <rlgl.h>
 
+#include <algorithm>
+#include <cassert>
+#include <component_sets.hpp>
 #include <components/base.hpp>
 #include <entt/entt.hpp>
+#include <integrator.hpp>
 #include <iostream>
 #include <math.hpp>
+#include <memory>
+#include <utility>
+#include <utils/destruction_buffer.hpp>
+#include <utils/playfield.hpp>
+#include <utils/process_profiler.hpp>
+#include <utils/spatial_hash.hpp>
+#include <utils/worker_pool.hpp>
+#include <vector>
 
 #include "components/physics.hpp"
 #include "raymath.h"
 
-struct physics_process : entt::process<physics_process, uint32_t>
+struct physics_process : entt::process<physics_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
-    physics_process(entt::registry& registry) :
-        registry(registry) {}
+    physics_process(entt::registry& registry, physics_integrator integrator = physics_integrator::SEMI_IMPLICIT_EULER) :
+        registry(registry),
+        integrator(integrator) {}
 
     void update(delta_type delta_time, void*)
     {
-        auto physics_view = registry.view<transform, physics>();
-        for (auto [entity, transform_data, physics_data] : physics_view.each())
-        {
-            physics_data.velocity = physics_data.velocity + physics_data.external_impulse * (delta_time / 1000.0f);
-            if (physics_data.drag > 0.0f)
-            {
-                physics_data.velocity = physics_data.velocity * (1.0f - physics_data.drag);
-            }
+        std::size_t visited = 0;
 
-            transform_data.position = transform_data.position + physics_data.velocity * (delta_time / 1000.0f);
-            transform_data.rotation = transform_data.rotation + physics_data.angular_velocity * (delta_time / 1000.0f);
+        each_body_page(registry, [this, delta_time, &visited](transform* transforms, physics* bodies, std::size_t count) {
+            integrate_bodies(transforms, bodies, count, delta_time, integrator);
+            visited += count;
+        });
 
-            physics_data.external_impulse = Vector2{0, 0};
-        }
+        profile_entities(visited);
     }
 
    protected:
     entt::registry& registry;
+    physics_integrator integrator;
+};
+
+enum class collision_broadphase
+{
+    BRUTE_FORCE,
+    SPATIAL_HASH,
+    // INFO: Runs both and asserts they agree, dispatches with the spatial hash results
+    VALIDATE,
 };
 
-struct collision_process : entt::process<collision_process, uint32_t>
+inline static bool circles_overlap(Vector2 position, float radius, Vector2 other_position, float other_radius)
 {
-    using delta_type = std::uint32_t;
+    auto distance = Vector2DistanceSqr(position, other_position);
+    return distance <= radius * radius + other_radius * other_radius;
+}
+
+// INFO: Closest approach of two circles moving linearly from their previous to their current
+// position, solved in the frame of the second one so only a segment vs point test is left.
+inline static bool swept_circles_overlap(const collider_proxy& proxy, const collider_proxy& other_proxy)
+{
+    Vector2 start = Vector2Subtract(proxy.previous_position, other_proxy.previous_position);
+    Vector2 end   = Vector2Subtract(proxy.position, other_proxy.position);
+    Vector2 delta = Vector2Subtract(end, start);
+
+    float length_sqr = Vector2DotProduct(delta, delta);
+    float t          = 0.0f;
+
+    if (length_sqr > 0.0f)
+    {
+        t = std::clamp(-Vector2DotProduct(start, delta) / length_sqr, 0.0f, 1.0f);
+    }
+
+    Vector2 closest = Vector2Add(start, Vector2Scale(delta, t));
 
-    collision_process(entt::registry& registry) :
-        registry(registry) {}
+    return Vector2DotProduct(closest, closest) <= proxy.radius * proxy.radius + other_proxy.radius * other_proxy.radius;
+}
+
+inline static bool proxies_overlap(const collider_proxy& proxy, const collider_proxy& other_proxy)
+{
+    if (proxy.swept || other_proxy.swept)
+        return swept_circles_overlap(proxy, other_proxy);
+
+    return circles_overlap(proxy.position, proxy.radius, other_proxy.position, other_proxy.radius);
+}
+
+struct collision_contact
+{
+    entt::entity entity;
+    entt::entity other_entity;
+};
+
+struct collision_process : entt::process<collision_process, float>
+{
+    using delta_type = float;
+
+    collision_process(entt::registry& registry, collision_broadphase broadphase = collision_broadphase::SPATIAL_HASH, float cell_size = 64.0f, std::size_t worker_count = 0) :
+        registry(registry),
+        broadphase(broadphase),
+        grid(cell_size)
+    {
+        contacts.reserve(1024);
+
+        if (worker_count > 0)
+        {
+            workers = std::make_unique<worker_pool>(worker_count);
+        }
+    }
 
     void update(delta_type delta_time, void*)
     {
-        auto collider_view = registry.view<transform, circle_collider>();
+        contacts.clear();
+
+        gather_proxies(delta_time);
 
-        for (auto [entity, transform_data, collision_data] : collider_view.each())
+        profile_entities(grid.proxies().size());
+
+        // INFO: Detection, only fills the contact buffer and never touches the registry
+        switch (broadphase)
         {
-            for (auto [other_entity, other_transform_data, other_collision_data] : collider_view.each())
+            case collision_broadphase::BRUTE_FORCE:
+                detect_brute_force();
+                break;
+            case collision_broadphase::SPATIAL_HASH:
+                detect_spatial_hash();
+                break;
+            case collision_broadphase::VALIDATE:
+                detect_spatial_hash();
+                validate_spatial_hash();
+                break;
+        }
+
+        // INFO: Resolution, callbacks are free to create entities and queue them for destruction
+        resolve_contacts();
+    }
+
+   protected:
+    // NOTE: Runs after physics_process and before boundary_process, so stepping back along the
+    // velocity gives the exact segment travelled this tick and never crosses a wrap.
+    void gather_proxies(float delta_time_seconds)
+    {
+        grid.clear();
+
+        each_collider(registry, [this, delta_time_seconds](entt::entity entity, transform& transform_data, circle_collider& collision_data, collision_filter& filter_data) {
+            // INFO: Parked prefabs have an empty filter and collide with nothing
+            if (filter_data.layer == 0)
+                return;
+
+            Vector2 previous_position = transform_data.position;
+
+            if (collision_data.continuous)
             {
-                if (entity == other_entity)
-                    continue;
+                if (auto physics_data = registry.try_get<physics>(entity); physics_data != nullptr)
+                {
+                    previous_position = transform_data.position - physics_data->velocity * delta_time_seconds;
+                }
+            }
 
-                auto distance = Vector2DistanceSqr(transform_data.position, other_transform_data.position);
-                if (distance > collision_data.radius * collision_data.radius + other_collision_data.radius * other_collision_data.radius)
-                    continue;
+            grid.insert(entity, previous_position, transform_data.position, collision_data.radius, filter_data);
+        });
+
+        // INFO: Same bounds boundary_process wraps around, so things can touch across the edges
+        auto camera_view = registry.view<Camera2D>();
+        if (!camera_view.empty())
+        {
+            grid.wrap(make_playfield(camera_view.get<Camera2D>(camera_view.front())));
+        }
+    }
+
+    void dispatch(entt::entity entity, entt::entity other_entity)
+    {
+        auto& collision_data = registry.get<circle_collider>(entity);
 
-                if (!collision_data.on_collision)
+        if (!collision_data.on_collision)
+            return;
+
+        collision_data.on_collision(registry, entity, other_entity);
+    }
+
+    // NOTE: Contacts are put in entity order and identical pairs are merged, so every broadphase
+    // resolves the same contacts in the same order. An entity takes part in all of its contacts
+    // until a callback queues it for destruction, its later contacts are skipped from then on.
+    void resolve_contacts()
+    {
+        for (auto& contact : contacts)
+        {
+            if (contact.other_entity < contact.entity)
+                std::swap(contact.entity, contact.other_entity);
+        }
+
+        std::sort(contacts.begin(), contacts.end(), [](const collision_contact& contact_a, const collision_contact& contact_b) {
+            return contact_a.entity != contact_b.entity ? contact_a.entity < contact_b.entity : contact_a.other_entity < contact_b.other_entity;
+        });
+
+        contacts.erase(std::unique(contacts.begin(), contacts.end(),
+                                   [](const collision_contact& contact_a, const collision_contact& contact_b) {
+                                       return contact_a.entity == contact_b.entity && contact_a.other_entity == contact_b.other_entity;
+                                   }),
+                       contacts.end());
+
+        const destruction_buffer& buffer = destruction_buffer::of(registry);
+
+        for (const auto& contact : contacts)
+        {
+            if (buffer.queued(contact.entity) || buffer.queued(contact.other_entity))
+                continue;
+
+            dispatch(contact.entity, contact.other_entity);
+            dispatch(contact.other_entity, contact.entity);
+        }
+    }
+
+    template<typename Func>
+    void each_brute_force_pair(Func func) const
+    {
+        const auto& proxies = grid.proxies();
+
+        for (std::size_t i = 0; i < proxies.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < proxies.size(); j++)
+            {
+                if (!proxy_pair_allowed(proxies[i], proxies[j]))
                     continue;
 
-                if (!registry.valid(entity) || !registry.valid(other_entity))
+                if (!proxies_overlap(proxies[i], proxies[j]))
                     continue;
 
-                collision_data.on_collision(registry, entity, other_entity);
+                func(proxies[i], proxies[j]);
             }
         }
     }
 
-   protected:
+    void detect_spatial_hash()
+    {
+        grid.build();
+
+        // PERF: Below a few hundred colliders waking the workers costs more than the tests
+        if (workers == nullptr || grid.proxies().size() < parallel_proxy_threshold)
+        {
+            grid.each_pair([this](const collider_proxy& proxy, const collider_proxy& other_proxy) {
+                if (!proxies_overlap(proxy, other_proxy))
+                    return;
+
+                contacts.push_back(collision_contact{proxy.entity, other_proxy.entity});
+            });
+
+            return;
+        }
+
+        detect_spatial_hash_parallel();
+    }
+
+    // INFO: Each partition is a contiguous range of cells with its own contact buffer, the buffers
+    // are appended in partition order so the contacts come out exactly as in the serial path.
+    void detect_spatial_hash_parallel()
+    {
+        const auto partition_count = static_cast<std::uint32_t>((workers->thread_count() + 1) * 4);
+
+        grid.partition(partition_count, partition_bounds);
+        partition_contacts.resize(partition_count);
+
+        auto detect_partition = [this](std::size_t index) {
+            auto& buffer = partition_contacts[index];
+            buffer.clear();
+
+            grid.each_pair(partition_bounds[index], partition_bounds[index + 1], [&buffer](const collider_proxy& proxy, const collider_proxy& other_proxy) {
+                if (!proxies_overlap(proxy, other_proxy))
+                    return;
+
+                buffer.push_back(collision_contact{proxy.entity, other_proxy.entity});
+            });
+        };
+
+        workers->run(partition_count, detect_partition);
+
+        for (const auto& buffer : partition_contacts)
+        {
+            contacts.insert(contacts.end(), buffer.begin(), buffer.end());
+        }
+    }
+
+    void detect_brute_force()
+    {
+        each_brute_force_pair([this](const collider_proxy& proxy, const collider_proxy& other_proxy) {
+            contacts.push_back(collision_contact{proxy.entity, other_proxy.entity});
+        });
+    }
+
+    void validate_spatial_hash()
+    {
+        std::vector<std::pair<entt::entity, entt::entity>> expected;
+        std::vector<std::pair<entt::entity, entt::entity>> found;
+
+        auto ordered = [](entt::entity entity, entt::entity other_entity) {
+            return entity < other_entity ? std::make_pair(entity, other_entity) : std::make_pair(other_entity, entity);
+        };
+
+        each_brute_force_pair([&](const collider_proxy& proxy, const collider_proxy& other_proxy) {
+            expected.push_back(ordered(proxy.entity, other_proxy.entity));
+        });
+
+        for (const auto& contact : contacts)
+        {
+            found.push_back(ordered(contact.entity, contact.other_entity));
+        }
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(found.begin(), found.end());
+
+        if (expected != found)
+        {
+            std::cerr << "Broadphase mismatch: brute force " << expected.size() << " pairs, spatial hash " << found.size() << " pairs" << std::endl;
+            assert(false);
+        }
+    }
+
     entt::registry& registry;
+    collision_broadphase broadphase;
+
+    spatial_hash grid;
+
+    std::vector<collision_contact> contacts;
+
+    static constexpr std::size_t parallel_proxy_threshold = 512;
+
+    std::unique_ptr<worker_pool> workers;
+    std::vector<std::uint32_t> partition_bounds;
+    std::vector<std::vector<collision_contact>> partition_contacts;
 };
 
 #endif // PHYSICS_PROCESSORS_HPP
@@ -4,20 +4,26 @@
 #include <raylib.h>
 #include <rlgl.h>
 
+#include <cmath>
+#include <component_sets.hpp>
 #include <components/base.hpp>
 #include <components/render.hpp>
+#include <cstdio>
 #include <entt/entt.hpp>
 #include <iomanip>
 #include <iostream>
 #include <math.hpp>
+#include <platform/platform.hpp>
 #include <sstream>
+#include <utils/playfield.hpp>
+#include <utils/process_profiler.hpp>
 
 #include "components/player.hpp"
 
 
-struct text_render_process : entt::process<text_render_process, std::uint32_t>
+struct text_render_process : entt::process<text_render_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     text_render_process(entt::registry& registry) :
         registry(registry) {}
@@ -26,8 +32,12 @@ struct text_render_process : entt::process<text_render_process, std::uint32_t>
     {
         auto text_view = registry.view<transform, text_render>();
 
+        std::size_t visited = 0;
+
         for (auto [entity, transform_data, render_data] : text_view.each())
         {
+            visited++;
+
             rlPushMatrix();
             rlTranslatef(transform_data.position.x, transform_data.position.y, 0.0f);
             rlRotatef(transform_data.rotation, 0.0f, 0.0f, 1.0f);
@@ -42,6 +52,8 @@ struct text_render_process : entt::process<text_render_process, std::uint32_t>
 
         for (auto [entity, transform_data, render_data] : dynamic_text_view.each())
         {
+            visited++;
+
             rlPushMatrix();
             rlTranslatef(transform_data.position.x, transform_data.position.y, 0.0f);
             rlRotatef(transform_data.rotation, 0.0f, 0.0f, 1.0f);
@@ -60,15 +72,17 @@ struct text_render_process : entt::process<text_render_process, std::uint32_t>
 
             rlPopMatrix();
         }
+
+        profile_entities(visited);
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct shape_render_process : entt::process<shape_render_process, std::uint32_t>
+struct shape_render_process : entt::process<shape_render_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     shape_render_process(entt::registry& registry) :
         registry(registry) {}
@@ -77,8 +91,12 @@ struct shape_render_process : entt::process<shape_render_process, std::uint32_t>
     {
         auto render_view = registry.view<transform, shape_render>();
 
+        std::size_t visited = 0;
+
         for (auto [entity, transform_data, render_data] : render_view.each())
         {
+            visited++;
+
             rlPushMatrix();
             rlTranslatef(transform_data.position.x, transform_data.position.y, 0.0f);
             rlRotatef(transform_data.rotation, 0.0f, 0.0f, 1.0f);
@@ -86,8 +104,7 @@ struct shape_render_process : entt::process<shape_render_process, std::uint32_t>
             switch (render_data.shape)
             {
                 case render_shape_type::TRIANGLE: {
-                    auto data = static_cast<Vector2*>(render_data.data);
-                    std::vector<Vector2> vertices(data, data + 3);
+                    const auto vertices = static_cast<const Vector2*>(render_data.data);
 
                     DrawTriangle(vertices[0], vertices[1], vertices[2],
                                  render_data.color);
@@ -108,33 +125,72 @@ struct shape_render_process : entt::process<shape_render_process, std::uint32_t>
 
             rlPopMatrix();
         }
+
+        profile_entities(visited);
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct sprite_render_process : entt::process<sprite_render_process, std::uint32_t>
+// INFO: Transform between the last two ticks, alpha 0 is where the tick started and 1 is where it
+// ended. Anything that wrapped during the tick is blended across the seam rather than the screen.
+inline static transform interpolate_transform(const previous_transform& previous, const transform& current, float alpha, Vector2 wrap_size)
 {
-    using delta_type = std::uint32_t;
+    Vector2 delta = current.position - previous.position;
+
+    if (wrap_size.x > 0.0f)
+        delta.x -= wrap_size.x * std::round(delta.x / wrap_size.x);
+
+    if (wrap_size.y > 0.0f)
+        delta.y -= wrap_size.y * std::round(delta.y / wrap_size.y);
+
+    const float rotation_delta = std::remainder(current.rotation - previous.rotation, 360.0f);
+
+    return transform{current.position - delta * (1.0f - alpha), current.rotation - rotation_delta * (1.0f - alpha)};
+}
+
+struct sprite_render_process : entt::process<sprite_render_process, float>
+{
+    using delta_type = float;
 
     sprite_render_process(entt::registry& registry) :
         registry(registry) {}
 
-    void update(delta_type delta_time, void*)
+    // INFO: data optionally points to the interpolation alpha as a float, without it the latest
+    // tick is drawn as is.
+    void update(delta_type delta_time, void* data)
     {
-        auto render_view = registry.view<transform, sprite_render>();
+        const float alpha = data != nullptr ? *static_cast<const float*>(data) : 1.0f;
 
-        for (auto [entity, transform_data, render_data] : render_view.each())
+        Vector2 wrap_size = Vector2{0, 0};
+        auto camera_view  = registry.view<Camera2D>();
+        if (!camera_view.empty())
         {
-            if (!IsTextureReady(render_data.texture))
+            wrap_size = make_playfield(camera_view.get<Camera2D>(camera_view.front())).size;
+        }
+
+        std::size_t visited = 0;
+
+        each_sprite(registry, [this, alpha, wrap_size, &visited](entt::entity entity, transform& transform_data, sprite_render& render_data) {
+            visited++;
+
+            // NOTE: Fully transparent sprites include the parked prefabs
+            if (render_data.tint.a == 0 || !IsTextureReady(render_data.texture))
             {
-                continue;
+                return;
+            }
+
+            transform drawn = transform_data;
+
+            if (auto previous_data = registry.try_get<previous_transform>(entity); previous_data != nullptr && alpha < 1.0f)
+            {
+                drawn = interpolate_transform(*previous_data, transform_data, alpha, wrap_size);
             }
 
             rlPushMatrix();
-            rlTranslatef(transform_data.position.x, transform_data.position.y, 0.0f);
-            rlRotatef(transform_data.rotation, 0.0f, 0.0f, 1.0f);
+            rlTranslatef(drawn.position.x, drawn.position.y, 0.0f);
+            rlRotatef(drawn.rotation, 0.0f, 0.0f, 1.0f);
 
             DrawTexturePro(
                 render_data.texture,
@@ -147,16 +203,18 @@ struct sprite_render_process : entt::process<sprite_render_process, std::uint32_
                 90, render_data.tint);
 
             rlPopMatrix();
-        }
+        });
+
+        profile_entities(visited);
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct sprite_sequence_process : entt::process<sprite_sequence_process, std::uint32_t>
+struct sprite_sequence_process : entt::process<sprite_sequence_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     sprite_sequence_process(entt::registry& registry) :
         registry(registry) {}
@@ -165,14 +223,16 @@ struct sprite_sequence_process : entt::process<sprite_sequence_process, std::uin
     {
         auto render_view = registry.view<sprite_sequence, sprite_render>();
 
-        float delta_time_seconds = delta_time / 1000.0f;
+        std::size_t visited = 0;
 
         for (auto [entity, sequence_data, render_data] : render_view.each())
         {
+            visited++;
+
             if (!sequence_data.update)
                 continue;
 
-            sequence_data.current_delta += delta_time_seconds;
+            sequence_data.current_delta += delta_time;
             if (sequence_data.current_delta < sequence_data.frame_time)
                 continue;
 
@@ -186,15 +246,17 @@ struct sprite_sequence_process : entt::process<sprite_sequence_process, std::uin
 
             render_data.source = sequence_data.frames->at(sequence_data.current_frame_index).source;
         }
+
+        profile_entities(visited);
     }
 
    protected:
     entt::registry& registry;
 };
 
-struct camera_process : entt::process<camera_process, std::uint32_t>
+struct camera_process : entt::process<camera_process, float>
 {
-    using delta_type = std::uint32_t;
+    using delta_type = float;
 
     camera_process(entt::registry& registry) :
         registry(registry) {}
@@ -214,4 +276,81 @@ struct camera_process : entt::process<camera_process, std::uint32_t>
     entt::registry& registry;
 };
 
+// INFO: F3 toggles a table with the time and entity count of every process in the last finished
+// frame. Processes that ran on several ticks of that frame are summed into one row.
+struct profiler_overlay_process : entt::process<profiler_overlay_process, float>
+{
+    using delta_type = float;
+
+    profiler_overlay_process(entt::registry& registry) :
+        registry(registry) {}
+
+    void update(delta_type delta_time, void*)
+    {
+        if (get_platform().is_key_pressed(KEY_F3))
+            visible = !visible;
+
+        if (!visible || !process_profiler::instance().read_frame(0, frame))
+            return;
+
+        std::size_t row_count = 0;
+
+        for (std::uint32_t i = 0; i < frame.sample_count; i++)
+        {
+            const process_sample& sample = frame.samples[i];
+
+            std::size_t row = 0;
+            while (row < row_count && rows[row].name != sample.name)
+            {
+                row++;
+            }
+
+            if (row == row_count)
+                rows[row_count++] = overlay_row{sample.name, 0, 0, 0};
+
+            rows[row].duration_ns += sample.duration_ns;
+            rows[row].entities += sample.entities;
+            rows[row].calls++;
+        }
+
+        // NOTE: The render scheduler runs inside the camera, so the corner is mapped to world space
+        auto camera_view = registry.view<Camera2D>();
+        Vector2 origin   = Vector2{8, 8};
+        if (!camera_view.empty())
+        {
+            origin = GetScreenToWorld2D(origin, camera_view.get<Camera2D>(camera_view.front()));
+        }
+
+        char line[160];
+
+        std::snprintf(line, sizeof(line), "frame %llu  %.3f ms", static_cast<unsigned long long>(frame.index), frame.duration_ns / 1e6);
+        DrawText(line, origin.x, origin.y, font_size, GREEN);
+
+        for (std::size_t row = 0; row < row_count; row++)
+        {
+            std::snprintf(line, sizeof(line), "%-32.*s %8.3f ms %6u ent x%u", static_cast<int>(rows[row].name.size()), rows[row].name.data(),
+                          rows[row].duration_ns / 1e6, rows[row].entities, rows[row].calls);
+            DrawText(line, origin.x, origin.y + (row + 1) * (font_size + 2), font_size, GREEN);
+        }
+    }
+
+   protected:
+    struct overlay_row
+    {
+        std::string_view name;
+        std::int64_t duration_ns;
+        std::uint32_t entities;
+        std::uint32_t calls;
+    };
+
+    static constexpr int font_size = 10;
+
+    entt::registry& registry;
+
+    bool visible = false;
+
+    profiled_frame frame;
+    std::array<overlay_row, max_samples_per_frame> rows;
+};
+
 #endif // RENDER_PROCESSORS_HPP
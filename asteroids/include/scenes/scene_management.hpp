@@ -1,41 +1,93 @@
 #ifndef SCENE_MANAGEMENT
 #define SCENE_MANAGEMENT
 
+#include <algorithm>
 #include <entt/entt.hpp>
+#include <functional>
 #include <memory>
+#include <thread>
+#include <utility>
 
 #include "components/asteroid.hpp"
 #include "components/enemy.hpp"
 #include "components/player.hpp"
+#include "platform/platform.hpp"
 #include "processors/base_processors.hpp"
 #include "processors/enemy_processors.hpp"
 #include "processors/physics_processors.hpp"
 #include "processors/render_processors.hpp"
 #include "raylib.h"
 #include "raymath.h"
+#include "utils/asset_loader.hpp"
+#include "utils/destruction_buffer.hpp"
+#include "utils/frame_phases.hpp"
 #include "utils/input_handler.hpp"
-#include "utils/state.hpp"
+#include "utils/prefab_pool.hpp"
+#include "utils/process_profiler.hpp"
+#include "utils/simulation_clock.hpp"
+#include "utils/static_state_machine.hpp"
+#include "utils/texture_cache.hpp"
+#include "utils/timer_queue.hpp"
+#include "utils/trace_writer.hpp"
 
 static const Color background_color = {15, 15, 15, 255};
 static const Color text_color       = {204, 191, 147, 255};
 
-static const void create_title_scene(std::shared_ptr<state>& scene_state)
+// INFO: Callbacks of one scene, built once by its create function and run every time the scene
+// is entered
+struct scene
+{
+    std::function<void()> on_enter;
+    std::function<void()> on_exit;
+    std::function<void(float)> on_update;
+};
+
+// INFO: Draws the frame through render_scheduler, platforms that present nothing skip it entirely
+static void draw_scene(entt::registry& registry, game_scheduler& render_scheduler, float delta_time, float alpha)
+{
+    if (!get_platform().begin_drawing())
+        return;
+
+    {
+        scoped_phase_timer timer(frame_phase::RENDER);
+
+        ClearBackground(background_color);
+
+        Camera2D camera = registry.get<Camera2D>(registry.view<Camera2D>().front());
+        BeginMode2D(camera);
+
+        render_scheduler.update(delta_time, &alpha);
+
+        EndMode2D();
+    }
+
+    scoped_phase_timer timer(frame_phase::PRESENT);
+    get_platform().end_drawing();
+}
+
+static const void create_title_scene(scene& scene_data, std::shared_ptr<simulation_clock> clock, std::shared_ptr<asset_loader> assets)
 {
     std::shared_ptr<entt::registry> registry = std::make_shared<entt::registry>();
 
-    std::shared_ptr<entt::scheduler> general_scheduler = std::make_shared<entt::scheduler>();
-    std::shared_ptr<entt::scheduler> render_scheduler  = std::make_shared<entt::scheduler>();
+    std::shared_ptr<game_scheduler> general_scheduler = std::make_shared<game_scheduler>();
+    std::shared_ptr<game_scheduler> render_scheduler  = std::make_shared<game_scheduler>();
 
-    auto on_enter = [registry, general_scheduler, render_scheduler]() {
-        general_scheduler->attach<physics_process>(*registry);
-        general_scheduler->attach<boundary_process>(*registry);
+    auto on_enter = [registry, general_scheduler, render_scheduler, assets]() {
+        // NOTE: Listed last to first, the scheduler updates the latest attached process first
+        // INFO: Animations are simulation state, they advance even when nothing gets drawn
+        attach_process<sprite_sequence_process>(*general_scheduler, *registry);
+        attach_process<boundary_process>(*general_scheduler, *registry);
+        attach_process<physics_process>(*general_scheduler, *registry);
+        attach_process<interpolation_snapshot_process>(*general_scheduler, *registry);
 
-        render_scheduler->attach<text_render_process>(*registry);
-        render_scheduler->attach<sprite_render_process>(*registry);
-        render_scheduler->attach<sprite_sequence_process>(*registry);
+        attach_process<text_render_process>(*render_scheduler, *registry);
+        attach_process<sprite_render_process>(*render_scheduler, *registry);
 
-        // INFO: Load textures
-        LoadTextureToEntity<GAME_TEXTURES::MAINTEXTURE>("resources/simpleSpace_tilesheet.png", *registry);
+        // INFO: Textures stay in the cache between scenes, only the first enter loads them
+        load_game_texture(GAME_TEXTURES::MAINTEXTURE);
+
+        // INFO: The game scene's textures decode in the background while the title shows
+        assets->start();
 
         // INFO: Create player
         spawn_main_camera(*registry);
@@ -63,8 +115,8 @@ static const void create_title_scene(std::shared_ptr<state>& scene_state)
             registry->emplace<text_render>(text_entity, text_component);
         };
 
-        float screenWidth  = GetScreenWidth();
-        float screenHeight = GetScreenHeight();
+        float screenWidth  = get_platform().screen_width();
+        float screenHeight = get_platform().screen_height();
 
         const char* title_text = "ASTEROIDS";
 
@@ -90,51 +142,48 @@ static const void create_title_scene(std::shared_ptr<state>& scene_state)
     };
 
     auto on_exit = [registry]() {
-        auto texture_view = registry->view<Texture2D>();
-
-        for (auto [entity, texture] : texture_view.each())
-        {
-            UnloadTexture(texture);
-        }
-
         registry->clear();
+        registry->ctx().erase<prefab_pools>();
+        registry->ctx().erase<destruction_buffer>();
+        registry->ctx().erase<timer_queue>();
     };
 
-    auto on_update = [registry, general_scheduler, render_scheduler](float delta_time) {
-        const uint32_t delta_time_ms = delta_time * 1000;
+    auto on_update = [registry, clock, general_scheduler, render_scheduler, assets](float delta_time) {
+        scoped_trace_zone zone("title on_update");
 
-        general_scheduler->update(delta_time_ms);
-
-        BeginDrawing();
-        ClearBackground(background_color);
+        assets->upload_decoded();
 
-        Camera2D camera = registry->get<Camera2D>(registry->view<Camera2D>().front());
-        BeginMode2D(camera);
-
-        render_scheduler->update(delta_time_ms);
+        for (std::uint32_t ticks = clock->advance(delta_time); ticks > 0; ticks--)
+        {
+            scoped_phase_timer timer(frame_phase::GENERAL);
+            general_scheduler->update(clock->tick_time());
+            current_frame_phase_times().ticks++;
+        }
 
-        EndMode2D();
-        EndDrawing();
+        draw_scene(*registry, *render_scheduler, delta_time, clock->alpha());
     };
 
-    scene_state = std::make_shared<state>(on_enter, on_exit, on_update);
+    scene_data = scene{on_enter, on_exit, on_update};
 }
 
-static const void create_score_scene(std::shared_ptr<state>& scene_state, std::shared_ptr<entt::registry> registry)
+static const void create_score_scene(scene& scene_data, std::shared_ptr<entt::registry> registry, std::shared_ptr<simulation_clock> clock)
 {
-    std::shared_ptr<entt::scheduler> general_scheduler = std::make_shared<entt::scheduler>();
-    std::shared_ptr<entt::scheduler> render_scheduler  = std::make_shared<entt::scheduler>();
+    std::shared_ptr<game_scheduler> general_scheduler = std::make_shared<game_scheduler>();
+    std::shared_ptr<game_scheduler> render_scheduler  = std::make_shared<game_scheduler>();
 
     auto on_enter = [registry, general_scheduler, render_scheduler]() {
-        general_scheduler->attach<physics_process>(*registry);
-        general_scheduler->attach<boundary_process>(*registry);
+        // NOTE: Listed last to first, the scheduler updates the latest attached process first
+        // INFO: Animations are simulation state, they advance even when nothing gets drawn
+        attach_process<sprite_sequence_process>(*general_scheduler, *registry);
+        attach_process<boundary_process>(*general_scheduler, *registry);
+        attach_process<physics_process>(*general_scheduler, *registry);
+        attach_process<interpolation_snapshot_process>(*general_scheduler, *registry);
 
-        render_scheduler->attach<text_render_process>(*registry);
-        render_scheduler->attach<sprite_render_process>(*registry);
-        render_scheduler->attach<sprite_sequence_process>(*registry);
+        attach_process<text_render_process>(*render_scheduler, *registry);
+        attach_process<sprite_render_process>(*render_scheduler, *registry);
 
-        // INFO: Load textures
-        LoadTextureToEntity<GAME_TEXTURES::MAINTEXTURE>("resources/simpleSpace_tilesheet.png", *registry);
+        // INFO: Textures stay in the cache between scenes, only the first enter loads them
+        load_game_texture(GAME_TEXTURES::MAINTEXTURE);
 
         // INFO: Create player
         spawn_main_camera(*registry);
@@ -174,8 +223,8 @@ static const void create_score_scene(std::shared_ptr<state>& scene_state, std::s
             }
         }
 
-        float screenWidth  = GetScreenWidth();
-        float screenHeight = GetScreenHeight();
+        float screenWidth  = get_platform().screen_width();
+        float screenHeight = get_platform().screen_height();
 
         const char* title_text = TextFormat("FINAL SCORE: %d", score);
 
@@ -223,69 +272,70 @@ static const void create_score_scene(std::shared_ptr<state>& scene_state, std::s
     };
 
     auto on_exit = [registry, general_scheduler, render_scheduler]() {
-        auto texture_view = registry->view<Texture2D>();
-
-        for (auto [entity, texture] : texture_view.each())
-        {
-            UnloadTexture(texture);
-        }
-
         general_scheduler->clear();
         render_scheduler->clear();
 
         registry->clear();
+        registry->ctx().erase<prefab_pools>();
+        registry->ctx().erase<destruction_buffer>();
+        registry->ctx().erase<timer_queue>();
     };
 
-    auto on_update = [registry, general_scheduler, render_scheduler](float delta_time) {
-        const uint32_t delta_time_ms = delta_time * 1000;
-
-        general_scheduler->update(delta_time_ms);
-
-        BeginDrawing();
-        ClearBackground(background_color);
+    auto on_update = [registry, clock, general_scheduler, render_scheduler](float delta_time) {
+        scoped_trace_zone zone("score on_update");
 
-        Camera2D camera = registry->get<Camera2D>(registry->view<Camera2D>().front());
-        BeginMode2D(camera);
-
-        render_scheduler->update(delta_time_ms);
+        for (std::uint32_t ticks = clock->advance(delta_time); ticks > 0; ticks--)
+        {
+            scoped_phase_timer timer(frame_phase::GENERAL);
+            general_scheduler->update(clock->tick_time());
+            current_frame_phase_times().ticks++;
+        }
 
-        EndMode2D();
-        EndDrawing();
+        draw_scene(*registry, *render_scheduler, delta_time, clock->alpha());
     };
 
-    scene_state = std::make_shared<state>(on_enter, on_exit, on_update);
+    scene_data = scene{on_enter, on_exit, on_update};
 }
-inline const void create_game_scene(std::shared_ptr<state>& scene_state, std::shared_ptr<entt::registry>& registry)
+inline const void create_game_scene(scene& scene_data, std::shared_ptr<entt::registry>& registry, std::shared_ptr<simulation_clock> clock)
 {
     registry = std::make_shared<entt::registry>();
 
     std::shared_ptr<input_handler> input = std::make_shared<input_handler>(*registry);
 
-    std::shared_ptr<entt::scheduler> general_scheduler = std::make_shared<entt::scheduler>();
-    std::shared_ptr<entt::scheduler> render_scheduler  = std::make_shared<entt::scheduler>();
-    std::shared_ptr<entt::scheduler> cleanup_scheduler = std::make_shared<entt::scheduler>();
+    std::shared_ptr<game_scheduler> general_scheduler = std::make_shared<game_scheduler>();
+    std::shared_ptr<game_scheduler> render_scheduler  = std::make_shared<game_scheduler>();
+    std::shared_ptr<game_scheduler> cleanup_scheduler = std::make_shared<game_scheduler>();
 
     auto on_enter = [registry, input, general_scheduler, render_scheduler, cleanup_scheduler]() {
-        general_scheduler->attach<lifetime_process>(*registry);
-        general_scheduler->attach<enemy_ai_process>(*registry);
-        general_scheduler->attach<trail_update_process>(*registry);
-        general_scheduler->attach<physics_process>(*registry);
-        general_scheduler->attach<collision_process>(*registry);
-        general_scheduler->attach<boundary_process>(*registry);
-
-        render_scheduler->attach<text_render_process>(*registry);
-        render_scheduler->attach<sprite_render_process>(*registry);
-        render_scheduler->attach<sprite_sequence_process>(*registry);
-        render_scheduler->attach<shape_render_process>(*registry);
-
-        cleanup_scheduler->attach<cleanup_process>(*registry);
-
-        // INFO: Load textures
-        LoadTextureToEntity<GAME_TEXTURES::MAINTEXTURE>("resources/simpleSpace_tilesheet.png", *registry);
-        LoadTextureToEntity<GAME_TEXTURES::PLANETEXTURE>("resources/simplePlanes_tilesheet.png", *registry);
-        LoadTextureToEntity<GAME_TEXTURES::SMOKETEXTURE>("resources/smoke_fx.png", *registry);
-        LoadTextureToEntity<GAME_TEXTURES::BULLETTEXTURE_BLUE>("resources/bullet_blue.png", *registry);
-        LoadTextureToEntity<GAME_TEXTURES::BULLETTEXTURE_RED>("resources/bullet_red.png", *registry);
+        // NOTE: Listed last to first, the scheduler updates the latest attached process first
+        // INFO: Animations are simulation state, they advance even when nothing gets drawn
+        attach_process<sprite_sequence_process>(*general_scheduler, *registry);
+        attach_process<boundary_process>(*general_scheduler, *registry);
+        // INFO: Spare cores run the collision detection once waves get large enough
+        const std::size_t collision_workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        attach_process<collision_process>(*general_scheduler, *registry, collision_broadphase::SPATIAL_HASH, 64.0f, collision_workers);
+        attach_process<physics_process>(*general_scheduler, *registry);
+        attach_process<trail_update_process>(*general_scheduler, *registry);
+        attach_process<enemy_ai_process>(*general_scheduler, *registry);
+        attach_process<lifetime_process>(*general_scheduler, *registry);
+        attach_process<interpolation_snapshot_process>(*general_scheduler, *registry);
+
+        // INFO: Drawn in reverse too, so the overlay ends up above everything else
+#if ASTEROIDS_PROFILING
+        render_scheduler->attach<profiler_overlay_process>(*registry);
+#endif
+        attach_process<text_render_process>(*render_scheduler, *registry);
+        attach_process<sprite_render_process>(*render_scheduler, *registry);
+        attach_process<shape_render_process>(*render_scheduler, *registry);
+
+        attach_process<cleanup_process>(*cleanup_scheduler, *registry);
+
+        // INFO: Textures stay in the cache between scenes, only the first enter loads them
+        load_game_texture(GAME_TEXTURES::MAINTEXTURE);
+        load_game_texture(GAME_TEXTURES::PLANETEXTURE);
+        load_game_texture(GAME_TEXTURES::SMOKETEXTURE);
+        load_game_texture(GAME_TEXTURES::BULLETTEXTURE_BLUE);
+        load_game_texture(GAME_TEXTURES::BULLETTEXTURE_RED);
 
         // INFO: Create player
         spawn_main_camera(*registry);
@@ -301,12 +351,6 @@ inline const void create_game_scene(std::shared_ptr<state>& scene_state, std::sh
     };
 
     auto on_exit = [registry, input, general_scheduler, render_scheduler, cleanup_scheduler]() {
-        auto texture_view = registry->view<Texture2D>();
-
-        for (auto [entity, texture] : texture_view.each())
-        {
-            UnloadTexture(texture);
-        }
         Player player_data;
 
         auto player_view   = registry->view<Player>();
@@ -322,6 +366,9 @@ inline const void create_game_scene(std::shared_ptr<state>& scene_state, std::sh
         cleanup_scheduler->clear();
 
         registry->clear();
+        registry->ctx().erase<prefab_pools>();
+        registry->ctx().erase<destruction_buffer>();
+        registry->ctx().erase<timer_queue>();
 
         if (player_data.game_over)
             return;
@@ -330,82 +377,160 @@ inline const void create_game_scene(std::shared_ptr<state>& scene_state, std::sh
         registry->emplace<Player>(new_entity, player_data);
     };
 
-    auto on_update = [registry, input, general_scheduler, render_scheduler, cleanup_scheduler](float delta_time) {
-        const uint32_t delta_time_ms = delta_time * 1000;
-
-        auto trailer_view = registry->view<entt::tag<player_trail_tag>, sprite_render>();
+    auto on_update = [registry, input, clock, general_scheduler, render_scheduler, cleanup_scheduler](float delta_time) {
+        scoped_trace_zone zone("game on_update");
 
-        for (auto [entity, sprite] : trailer_view.each())
+        // INFO: Zero or more fixed ticks, input is sampled and dead entities are cleaned up every tick
+        for (std::uint32_t ticks = clock->advance(delta_time); ticks > 0; ticks--)
         {
-            sprite.tint = Color{0, 0, 0, 0};
-        }
+            {
+                scoped_phase_timer timer(frame_phase::INPUT);
 
-        input->handle_input();
+                auto trailer_view = registry->view<entt::tag<player_trail_tag>, sprite_render>();
 
-        general_scheduler->update(delta_time_ms);
+                for (auto [entity, sprite] : trailer_view.each())
+                {
+                    sprite.tint = Color{0, 0, 0, 0};
+                }
 
-        BeginDrawing();
-        ClearBackground(background_color);
+                input->handle_input();
+            }
 
-        Camera2D camera = registry->get<Camera2D>(registry->view<Camera2D>().front());
-        BeginMode2D(camera);
+            {
+                scoped_phase_timer timer(frame_phase::GENERAL);
+                general_scheduler->update(clock->tick_time());
+            }
 
-        render_scheduler->update(delta_time_ms);
+            {
+                scoped_phase_timer timer(frame_phase::CLEANUP);
+                cleanup_scheduler->update(clock->tick_time());
+            }
 
-        EndMode2D();
-        EndDrawing();
+            current_frame_phase_times().ticks++;
+        }
 
-        cleanup_scheduler->update(delta_time_ms);
+        draw_scene(*registry, *render_scheduler, delta_time, clock->alpha());
     };
 
-    scene_state = std::make_shared<state>(on_enter, on_exit, on_update);
+    scene_data = scene{on_enter, on_exit, on_update};
 }
 
-static const state_machine create_game_state_machine()
+// INFO: What the scene states share. The scenes are built once, the states only run them.
+struct game_scenes
 {
-    std::shared_ptr<state> title_scene;
-    std::shared_ptr<state> game_scene;
-    std::shared_ptr<state> score_scene;
+    scene title;
+    scene game;
+    scene score;
 
     std::shared_ptr<entt::registry> game_registry;
+    std::shared_ptr<asset_loader> assets;
+
+    // INFO: SPACE was pressed on the title screen, the game starts once its textures are in
+    bool start_requested = false;
+};
+
+template<scene game_scenes::*Scene>
+struct scene_state
+{
+    void on_enter(game_scenes& scenes) { (scenes.*Scene).on_enter(); }
+    void on_exit(game_scenes& scenes) { (scenes.*Scene).on_exit(); }
+    void update(game_scenes& scenes, float delta_time) { (scenes.*Scene).on_update(delta_time); }
+};
+
+using title_scene_state = scene_state<&game_scenes::title>;
+using game_scene_state  = scene_state<&game_scenes::game>;
+using score_scene_state = scene_state<&game_scenes::score>;
+
+struct title_to_game
+{
+    static constexpr const char* name = "TITLE TO GAME";
+
+    bool operator()(game_scenes& scenes) const
+    {
+        if (get_platform().is_key_pressed(KEY_SPACE))
+            scenes.start_requested = true;
 
-    create_game_scene(game_scene, game_registry);
-    create_title_scene(title_scene);
-    create_score_scene(score_scene, game_registry);
+        if (!scenes.start_requested || !scenes.assets->ready())
+            return false;
 
-    state_machine game_state_machine(title_scene);
+        scenes.start_requested = false;
+        return true;
+    }
+};
 
-    title_scene->add_transition([]() {
-        return IsKeyPressed(KEY_SPACE);
-    },
-                                game_scene, "TITLE TO GAME");
+struct game_to_game
+{
+    static constexpr const char* name = "GAME TO GAME";
 
-    game_scene->add_transition([game_registry]() {
-        auto player_view   = game_registry->view<Player>();
+    bool operator()(game_scenes& scenes) const
+    {
+        auto player_view   = scenes.game_registry->view<Player>();
         auto player_entity = player_view.front();
 
-        if (!game_registry->valid(player_entity))
+        if (!scenes.game_registry->valid(player_entity))
             return false;
 
-        auto& player_data = game_registry->get<Player>(player_entity);
+        auto& player_data = scenes.game_registry->get<Player>(player_entity);
 
-        return player_data.game_over && IsKeyPressed(KEY_SPACE);
-    },
-                               game_scene, "GAME TO GAME");
+        return player_data.game_over && get_platform().is_key_pressed(KEY_SPACE);
+    }
+};
+
+struct game_to_score
+{
+    static constexpr const char* name = "GAME TO SCORE";
+
+    bool operator()(game_scenes& scenes) const
+    {
+        auto asteroid_view = scenes.game_registry->view<asteroid>();
+        auto enemy_view    = scenes.game_registry->view<entt::tag<enemy_tag>>();
+        int count          = asteroid_view.size() + enemy_view.size();
+        return count <= 0;
+    }
+};
+
+struct score_to_game
+{
+    static constexpr const char* name = "SCORE TO GAME";
+
+    bool operator()(game_scenes&) const { return get_platform().is_key_pressed(KEY_SPACE); }
+};
+
+using scene_state_machine = static_state_machine<game_scenes,
+                                                 state_list<title_scene_state, game_scene_state, score_scene_state>,
+                                                 transition_list<transition<title_scene_state, game_scene_state, title_to_game>,
+                                                                 transition<game_scene_state, game_scene_state, game_to_game>,
+                                                                 transition<game_scene_state, score_scene_state, game_to_score>,
+                                                                 transition<score_scene_state, game_scene_state, score_to_game>>>;
+
+// INFO: The scenes and the machine that moves between them, starting on the title screen
+class game_state_machine {
+   public:
+    game_state_machine(game_scenes scenes) :
+        _scenes(std::move(scenes)) {}
+
+    void start() { _machine.start(_scenes); }
+    void update(float delta_time) { _machine.update(_scenes, delta_time); }
+    void stop() { _machine.stop(_scenes); }
+
+   protected:
+    game_scenes _scenes;
+    scene_state_machine _machine;
+};
+
+static game_state_machine create_game_state_machine(std::uint32_t tick_rate = default_tick_rate)
+{
+    // INFO: One clock for every scene, time left over when a scene ends carries into the next one
+    std::shared_ptr<simulation_clock> clock = std::make_shared<simulation_clock>(tick_rate);
 
-    game_scene->add_transition([game_registry]() { 
-			auto asteroid_view = game_registry->view<asteroid>();
-			auto enemy_view = game_registry->view<entt::tag<enemy_tag>>();
-			int count = asteroid_view.size() + enemy_view.size();
-			return count <= 0; },
-                               score_scene, "GAME TO SCORE");
+    game_scenes scenes;
+    scenes.assets = std::make_shared<asset_loader>();
 
-    score_scene->add_transition([game_registry]() {
-        return IsKeyPressed(KEY_SPACE);
-    },
-                                game_scene, "SCORE TO GAME");
+    create_game_scene(scenes.game, scenes.game_registry, clock);
+    create_title_scene(scenes.title, clock, scenes.assets);
+    create_score_scene(scenes.score, scenes.game_registry, clock);
 
-    return game_state_machine;
+    return game_state_machine(std::move(scenes));
 }
 
 #endif // SCENE_MANAGEMENT
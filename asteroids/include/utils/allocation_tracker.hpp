@@ -0,0 +1,92 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// INFO: Build with ASTEROIDS_TRACK_ALLOCATIONS=1 (premake --track-allocations) to replace the
+// global operator new and delete with counting versions. Every allocation is charged to the zone
+// open on the allocating thread, processes and frame phases open one each. Without the flag the
+// zones are empty and the global operators are the standard ones.
+#ifndef ASTEROIDS_TRACK_ALLOCATIONS
+#define ASTEROIDS_TRACK_ALLOCATIONS 0
+#endif
+
+struct allocation_counts
+{
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes       = 0;
+    std::uint64_t frees       = 0;
+};
+
+class allocation_tracker {
+   public:
+    static constexpr std::size_t max_zones = 64;
+
+    // INFO: Zone of everything allocated outside a zone, and on threads that never open one
+    static constexpr std::size_t untracked_zone = 0;
+
+    static allocation_tracker& instance();
+
+    allocation_tracker(const allocation_tracker&)            = delete;
+    allocation_tracker& operator=(const allocation_tracker&) = delete;
+
+    // INFO: Index of the zone called name, registered on first use. Zones past max_zones are
+    // charged to untracked_zone.
+    // NOTE: Zones are only opened by the thread running the scenes, so registering needs no lock
+    std::size_t zone(std::string_view name);
+    std::size_t zone_count() const { return _zone_count; }
+    std::string_view zone_name(std::size_t zone) const { return _names[zone]; }
+
+    // INFO: Opens zone on the calling thread and returns the one it replaces
+    std::size_t enter_zone(std::size_t zone);
+
+    void record_allocation(std::size_t bytes);
+    void record_free();
+
+    allocation_counts zone_counts(std::size_t zone) const;
+    allocation_counts totals() const;
+
+   protected:
+    constexpr allocation_tracker() = default;
+
+    struct zone_counters
+    {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> frees{0};
+    };
+
+    // NOTE: Fixed size and never freed, operator new can run before and after everything else
+    std::array<std::string_view, max_zones> _names = {"untracked"};
+    std::array<zone_counters, max_zones> _counters = {};
+    std::size_t _zone_count                        = 1;
+};
+
+class scoped_allocation_zone {
+   public:
+#if ASTEROIDS_TRACK_ALLOCATIONS
+    scoped_allocation_zone(std::string_view name) :
+        _previous(allocation_tracker::instance().enter_zone(allocation_tracker::instance().zone(name))) {}
+
+    ~scoped_allocation_zone()
+    {
+        allocation_tracker::instance().enter_zone(_previous);
+    }
+#else
+    scoped_allocation_zone(std::string_view) {}
+#endif
+
+    scoped_allocation_zone(const scoped_allocation_zone&)            = delete;
+    scoped_allocation_zone& operator=(const scoped_allocation_zone&) = delete;
+
+#if ASTEROIDS_TRACK_ALLOCATIONS
+   protected:
+    std::size_t _previous;
+#endif
+};
+
+#endif // ALLOCATION_TRACKER_HPP
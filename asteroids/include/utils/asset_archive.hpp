@@ -0,0 +1,88 @@
+#ifndef ASSET_ARCHIVE_HPP
+#define ASSET_ARCHIVE_HPP
+
+#include <raylib.h>
+
+#include <components/base.hpp>
+#include <cstdint>
+#include <utils/mapped_file.hpp>
+#include <vector>
+
+// INFO: Archive of pre-decoded textures written by tools/asset_packer. A header, a table of
+// entries and the RGBA8 pixels of each texture, every field little endian. Pixels start on a
+// 64 byte boundary so they can be handed to the upload right out of the mapping.
+static const char asset_archive_magic[4]        = {'A', 'S', 'T', 'P'};
+static const std::uint32_t asset_archive_version = 2;
+static const std::uint32_t asset_archive_align   = 64;
+
+// INFO: Written next to the PNGs it was packed from, the game falls back on them without it
+static const char* const game_archive_path = "resources/textures.pak";
+
+struct asset_archive_header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entry_count;
+    std::uint32_t reserved;
+};
+
+enum asset_archive_flags : std::uint32_t
+{
+    // INFO: Pixels are deflated, uploading them needs a decompressed copy
+    ASSET_COMPRESSED = 1
+};
+
+struct asset_archive_entry
+{
+    // INFO: A GAME_TEXTURES value
+    std::uint32_t texture_id;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t flags;
+
+    // INFO: Offset from the start of the file, size as stored and size once decompressed
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint64_t unpacked_size;
+
+    // INFO: Size and FNV-1a hash of the PNG the entry was packed from. The game only compares
+    // the size, asset_packer --check compares the hash before the archive ships.
+    std::uint64_t source_size;
+    std::uint64_t source_hash;
+};
+
+static_assert(sizeof(asset_archive_header) == 16, "asset_archive_header is read straight from the file");
+static_assert(sizeof(asset_archive_entry) == 56, "asset_archive_entry is read straight from the file");
+
+// INFO: Size of a source file without reading it, false when it is missing
+bool asset_source_size(const char* path, std::uint64_t& size);
+
+class asset_archive {
+   public:
+    // INFO: Maps the file and checks its table, returns false and stays closed on a missing,
+    // outdated or truncated archive. Entries whose PNG changed size since packing are left out,
+    // so the texture loads from the PNG until asset_packer runs again.
+    bool open(const char* path);
+    void close();
+
+    bool is_open() const { return _file.is_open(); }
+    bool contains(GAME_TEXTURES texture_id) const { return find(texture_id) != nullptr; }
+    const asset_archive_entry* find(GAME_TEXTURES texture_id) const;
+    // INFO: Stored bytes of the entry, still deflated when it is compressed
+    const unsigned char* pixels(const asset_archive_entry& entry) const { return _file.data() + entry.offset; }
+
+    // INFO: Main thread only. Uploads straight from the mapping, only compressed entries are
+    // copied, into a buffer freed right after the upload.
+    Texture2D upload(GAME_TEXTURES texture_id) const;
+
+   protected:
+    mapped_file _file;
+
+    // INFO: Entries still matching their PNG, pointing into the mapping
+    std::vector<const asset_archive_entry*> _entries;
+};
+
+// INFO: Opened on first use from game_archive_path, a closed archive when the file is missing
+asset_archive& get_asset_archive();
+
+#endif // ASSET_ARCHIVE_HPP
@@ -0,0 +1,60 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <raylib.h>
+
+#include <components/base.hpp>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// INFO: Decodes the game textures on a worker thread while the title scene runs. The main
+// thread uploads what has been decoded so far once per frame, so by the time the game scene
+// starts its textures are already in the texture cache and entering it touches no file.
+// Textures found in the asset archive are stored decoded and skip the worker.
+class asset_loader {
+   public:
+    asset_loader() = default;
+    ~asset_loader();
+
+    asset_loader(const asset_loader&)            = delete;
+    asset_loader& operator=(const asset_loader&) = delete;
+
+    // INFO: Starts decoding every game texture the cache does not hold yet and returns at once.
+    // Calling it again while a batch is pending does nothing.
+    void start();
+
+    // INFO: Main thread only. Uploads up to max_uploads decoded images, returns how many.
+    std::size_t upload_decoded(std::size_t max_uploads = 2);
+
+    // INFO: Fraction of the batch that is uploaded, 1 when nothing is pending
+    float progress() const;
+    bool ready() const { return _uploaded == _requested.size(); }
+
+    // INFO: Main thread only. Waits for the worker and uploads everything left, for whoever
+    // cannot wait for the frames to do it.
+    void finish();
+
+   protected:
+    struct decoded_image
+    {
+        GAME_TEXTURES texture_id;
+        Image image;
+    };
+
+    void decode(std::vector<GAME_TEXTURES> texture_ids);
+
+    std::thread _worker;
+
+    std::vector<GAME_TEXTURES> _requested;
+    // INFO: Requested textures found in the asset archive, uploaded without a decode
+    std::vector<GAME_TEXTURES> _archived;
+    std::size_t _uploaded = 0;
+
+    // INFO: Handed over from the worker, guarded by _mutex
+    mutable std::mutex _mutex;
+    std::vector<decoded_image> _decoded;
+};
+
+#endif // ASSET_LOADER_HPP
@@ -0,0 +1,33 @@
+#ifndef DESTRUCTION_BUFFER_HPP
+#define DESTRUCTION_BUFFER_HPP
+
+#include <cstddef>
+#include <entt/entt.hpp>
+
+// INFO: Entities killed during a tick, in the registry context. Systems queue them instead of
+// destroying them on the spot, cleanup_process flushes the buffer once per tick so nothing
+// disappears while a view is being iterated.
+class destruction_buffer {
+   public:
+    static destruction_buffer& of(entt::registry& registry);
+
+    // INFO: Queuing an entity twice in the same tick is harmless, it is only flushed once
+    void queue(entt::registry& registry, entt::entity entity);
+    bool queued(entt::entity entity) const { return _destroyed.contains(entity) || _parked.contains(entity); }
+    std::size_t size() const { return _destroyed.size() + _parked.size(); }
+
+    // INFO: Parks the pooled entities and destroys the rest with one batched destroy, which
+    // removes them from each component pool in a single pass.
+    void flush(entt::registry& registry);
+
+   protected:
+    entt::sparse_set _destroyed;
+    entt::sparse_set _parked;
+};
+
+inline void destroy_deferred(entt::registry& registry, entt::entity entity)
+{
+    destruction_buffer::of(registry).queue(registry, entity);
+}
+
+#endif // DESTRUCTION_BUFFER_HPP
@@ -0,0 +1,66 @@
+#ifndef FRAME_PHASES_HPP
+#define FRAME_PHASES_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utils/allocation_tracker.hpp>
+#include <utils/trace_writer.hpp>
+
+// INFO: Coarse steps every scene frame goes through, the schedulers run in general, cleanup and render
+enum class frame_phase : std::uint8_t
+{
+    INPUT,
+    GENERAL,
+    CLEANUP,
+    RENDER,
+    PRESENT,
+    COUNT,
+};
+
+static const std::size_t frame_phase_count = static_cast<std::size_t>(frame_phase::COUNT);
+
+static const char* const frame_phase_names[frame_phase_count] = {"input", "general", "cleanup", "render", "present"};
+
+struct frame_phase_times
+{
+    double seconds[frame_phase_count] = {};
+    std::uint32_t ticks               = 0;
+};
+
+// INFO: Times of the frame in progress. Scenes add to it, whoever drives the frame loop reads it
+// and resets it once the frame is over.
+inline frame_phase_times& current_frame_phase_times()
+{
+    static frame_phase_times times;
+    return times;
+}
+
+// PERF: Two clock reads per phase and frame, cheap enough to always stay on. While tracing the
+// phase also becomes a zone, reusing the same two reads.
+class scoped_phase_timer {
+   public:
+    scoped_phase_timer(frame_phase phase) :
+        _phase(phase),
+        _allocation_zone(frame_phase_names[static_cast<std::size_t>(phase)]),
+        _start(std::chrono::steady_clock::now()) {}
+
+    ~scoped_phase_timer()
+    {
+        const auto end = std::chrono::steady_clock::now();
+        current_frame_phase_times().seconds[static_cast<std::size_t>(_phase)] += std::chrono::duration<double>(end - _start).count();
+
+        if (trace_writer::instance().enabled())
+            trace_writer::instance().write_zone(frame_phase_names[static_cast<std::size_t>(_phase)], _start, end);
+    }
+
+    scoped_phase_timer(const scoped_phase_timer&)            = delete;
+    scoped_phase_timer& operator=(const scoped_phase_timer&) = delete;
+
+   protected:
+    frame_phase _phase;
+    scoped_allocation_zone _allocation_zone;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#endif // FRAME_PHASES_HPP
@@ -0,0 +1,29 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+
+// INFO: Read only memory mapping of a whole file. Pages are faulted in by the OS on first touch
+// and, being clean file pages, can be dropped again under memory pressure at no cost.
+class mapped_file {
+   public:
+    mapped_file() = default;
+    ~mapped_file();
+
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    // INFO: Returns false when the file is missing or empty, the mapping stays closed then
+    bool open(const char* path);
+    void close();
+
+    bool is_open() const { return _data != nullptr; }
+    const unsigned char* data() const { return _data; }
+    std::size_t size() const { return _size; }
+
+   protected:
+    const unsigned char* _data = nullptr;
+    std::size_t _size          = 0;
+};
+
+#endif // MAPPED_FILE_HPP
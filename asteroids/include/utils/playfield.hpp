@@ -0,0 +1,30 @@
+#ifndef PLAYFIELD_HPP
+#define PLAYFIELD_HPP
+
+#include <raylib.h>
+
+#include <platform/platform.hpp>
+
+// INFO: How far past the screen edges entities travel before wrapping around
+static const float playfield_border_width = 50.0f;
+
+// INFO: World space rectangle that boundary_process wraps entities around, the playfield
+// behaves as a torus with a period of size on each axis.
+struct playfield
+{
+    Vector2 min;
+    Vector2 size;
+};
+
+inline static playfield make_playfield(const Camera2D& camera, float border_width = playfield_border_width)
+{
+    const float screen_width  = get_platform().screen_width();
+    const float screen_height = get_platform().screen_height();
+
+    Vector2 min = GetScreenToWorld2D(Vector2{-border_width, -border_width}, camera);
+    Vector2 max = GetScreenToWorld2D(Vector2{screen_width + border_width, screen_height + border_width}, camera);
+
+    return playfield{min, Vector2{max.x - min.x, max.y - min.y}};
+}
+
+#endif // PLAYFIELD_HPP
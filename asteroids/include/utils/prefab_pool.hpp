@@ -0,0 +1,93 @@
+#ifndef PREFAB_POOL_HPP
+#define PREFAB_POOL_HPP
+
+#include <array>
+#include <components/base.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <vector>
+
+// INFO: Short lived prefabs that are parked instead of destroyed
+enum class pooled_prefab : std::uint8_t
+{
+    BULLET,
+    EXPLOSION,
+    SMOKE,
+    COUNT,
+};
+
+static const std::size_t pooled_prefab_count = static_cast<std::size_t>(pooled_prefab::COUNT);
+
+static const char* const pooled_prefab_names[pooled_prefab_count] = {"bullet", "explosion", "smoke"};
+
+// INFO: Marks an entity as part of a prefab pool. A parked entity keeps every component, with
+// values that make the systems skip it: no velocity, an empty collision filter, a transparent
+// sprite, a stopped sequence and a lifetime that never ends.
+struct pooled
+{
+    pooled_prefab prefab;
+    bool active;
+};
+
+struct prefab_pool_stats
+{
+    std::uint32_t active;
+    std::uint32_t parked;
+    // INFO: Most entities of the prefab alive at once
+    std::uint32_t high_water;
+
+    std::uint64_t created;
+    std::uint64_t reused;
+};
+
+// INFO: Lives in the registry context, one free list per prefab. Spawning takes parked entities
+// first and only creates what is missing, so steady state firing never touches the pools of
+// the components.
+class prefab_pools {
+   public:
+    static prefab_pools& of(entt::registry& registry);
+
+    // INFO: Moves up to count parked entities into entities, returns how many. The caller
+    // overwrites their components and creates the rest.
+    std::size_t acquire(entt::registry& registry, pooled_prefab prefab, entt::entity* entities, std::size_t count);
+    // INFO: Counts fresh entities the caller created and tagged with pooled
+    void created(pooled_prefab prefab, std::size_t count);
+
+    void park(entt::registry& registry, entt::entity entity);
+
+    const prefab_pool_stats& stats(pooled_prefab prefab) const { return _stats[static_cast<std::size_t>(prefab)]; }
+
+   protected:
+    void activated(pooled_prefab prefab, std::size_t count);
+
+    std::array<std::vector<entt::entity>, pooled_prefab_count> _parked;
+    std::array<prefab_pool_stats, pooled_prefab_count> _stats = {};
+};
+
+// INFO: Gives a reused entity the values a fresh spawn would have inserted. Replacing rather
+// than assigning fires the update signals, which is what restarts the lifetime timer.
+template<typename... Type>
+void assign_components(entt::registry& registry, entt::entity entity, const Type&... values)
+{
+    (registry.replace<Type>(entity, values), ...);
+
+    // NOTE: Otherwise the first frame blends in from where the entity was parked
+    if (auto previous_data = registry.try_get<previous_transform>(entity); previous_data != nullptr)
+    {
+        const auto& transform_data = registry.get<transform>(entity);
+        *previous_data             = previous_transform{transform_data.position, transform_data.rotation};
+    }
+}
+
+// INFO: False for destroyed entities and for parked ones
+inline bool is_spawned(const entt::registry& registry, entt::entity entity)
+{
+    if (!registry.valid(entity))
+        return false;
+
+    const auto pooled_data = registry.try_get<pooled>(entity);
+    return pooled_data == nullptr || pooled_data->active;
+}
+
+#endif // PREFAB_POOL_HPP
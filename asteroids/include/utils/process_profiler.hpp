@@ -0,0 +1,164 @@
+#ifndef PROCESS_PROFILER_HPP
+#define PROCESS_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <entt/entt.hpp>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <utils/allocation_tracker.hpp>
+#include <utils/simulation_clock.hpp>
+
+// INFO: Build with ASTEROIDS_PROFILING=1 (premake --profiling) to time every scheduler process.
+// When it is 0 the profile_* helpers are empty and, unless allocations are tracked,
+// attach_process is a plain attach, nothing of the profiler ends up in the frame.
+#ifndef ASTEROIDS_PROFILING
+#define ASTEROIDS_PROFILING 0
+#endif
+
+struct process_sample
+{
+    std::string_view name;
+
+    // INFO: Nanoseconds since the profiler was created
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+
+    std::uint32_t entities;
+};
+
+static const std::size_t max_samples_per_frame = 128;
+
+struct profiled_frame
+{
+    std::uint64_t index;
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+
+    std::uint32_t sample_count;
+    // INFO: Samples that did not fit, a frame running many ticks can overflow
+    std::uint32_t dropped_samples;
+
+    std::array<process_sample, max_samples_per_frame> samples;
+};
+
+// INFO: Collects one sample per process update into the frame in progress and publishes finished
+// frames into a ring of the last frame_capacity frames. Samples are written by the thread running
+// the schedulers, the ring can be read from any thread without locks.
+class process_profiler {
+   public:
+    static constexpr std::size_t frame_capacity = 256;
+
+    static process_profiler& instance();
+
+    process_profiler(const process_profiler&)            = delete;
+    process_profiler& operator=(const process_profiler&) = delete;
+
+    void begin_sample(std::string_view name);
+    void end_sample();
+    // INFO: Adds to the entity count of the open sample
+    void add_entities(std::uint32_t count);
+
+    // INFO: Publishes the frame in progress and starts the next one
+    void next_frame();
+
+    // INFO: Copies the frame published frames_ago frames before the latest one. False when that
+    // frame does not exist yet or got overwritten while copying.
+    bool read_frame(std::size_t frames_ago, profiled_frame& frame) const;
+    std::uint64_t published_frames() const { return _published.load(std::memory_order_acquire); }
+
+    // INFO: Writes every frame still in the ring as CSV, oldest first
+    void dump(std::FILE* file) const;
+
+   protected:
+    process_profiler();
+
+    std::int64_t now() const;
+
+    // NOTE: Seqlock, the sequence is odd while the slot is being written and 2 * (index + 1) once
+    // frame index is complete. Readers retry on a mismatch instead of blocking the writer.
+    struct frame_slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        profiled_frame frame;
+    };
+
+    std::chrono::steady_clock::time_point _epoch;
+
+    std::unique_ptr<frame_slot[]> _slots;
+    std::atomic<std::uint64_t> _published{0};
+
+    profiled_frame _current;
+    std::size_t _open_sample = max_samples_per_frame;
+};
+
+// INFO: Runs Process and records how long each of its updates took and what it allocated, as far
+// as either is built in
+template<typename Process>
+struct profiled_process : entt::process<profiled_process<Process>, float>
+{
+    using delta_type = float;
+
+    template<typename... Args>
+    profiled_process(Args&&... args) :
+        process(std::forward<Args>(args)...) {}
+
+    void update(delta_type delta_time, void* data)
+    {
+        scoped_allocation_zone allocation_zone(entt::type_name<Process>::value());
+
+#if ASTEROIDS_PROFILING
+        process_profiler::instance().begin_sample(entt::type_name<Process>::value());
+        process.update(delta_time, data);
+        process_profiler::instance().end_sample();
+#else
+        process.update(delta_time, data);
+#endif
+    }
+
+    Process process;
+};
+
+template<typename Process, typename... Args>
+void attach_process(game_scheduler& scheduler, Args&&... args)
+{
+#if ASTEROIDS_PROFILING || ASTEROIDS_TRACK_ALLOCATIONS
+    scheduler.attach<profiled_process<Process>>(std::forward<Args>(args)...);
+#else
+    scheduler.attach<Process>(std::forward<Args>(args)...);
+#endif
+}
+
+// INFO: Processes report how many entities an update went through
+inline void profile_entities(std::size_t count)
+{
+#if ASTEROIDS_PROFILING
+    process_profiler::instance().add_entities(static_cast<std::uint32_t>(count));
+#endif
+}
+
+// INFO: Called by the frame loop once the frame is over
+inline void profile_next_frame()
+{
+#if ASTEROIDS_PROFILING
+    process_profiler::instance().next_frame();
+#endif
+}
+
+inline void profile_dump(const char* path)
+{
+#if ASTEROIDS_PROFILING
+    if (std::FILE* file = std::fopen(path, "w"); file != nullptr)
+    {
+        process_profiler::instance().dump(file);
+        std::fclose(file);
+    }
+#endif
+}
+
+#endif // PROCESS_PROFILER_HPP
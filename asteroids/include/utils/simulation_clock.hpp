@@ -0,0 +1,72 @@
+#ifndef SIMULATION_CLOCK_HPP
+#define SIMULATION_CLOCK_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <entt/entt.hpp>
+
+// INFO: Processes take their delta time in seconds
+using game_scheduler = entt::basic_scheduler<float>;
+
+static const std::uint32_t default_tick_rate = 60;
+
+// INFO: Turns variable frame times into a whole number of fixed ticks. Time that does not add up
+// to a full tick carries over to the next frame, alpha() is how far the frame sits between the
+// last tick and the next one, for the renderer to interpolate with.
+class simulation_clock {
+   public:
+    simulation_clock(std::uint32_t tick_rate = default_tick_rate, std::uint32_t max_ticks_per_frame = 8) :
+        _max_ticks_per_frame(max_ticks_per_frame)
+    {
+        set_tick_rate(tick_rate);
+    }
+
+    void set_tick_rate(std::uint32_t tick_rate)
+    {
+        _tick_rate     = tick_rate > 0 ? tick_rate : default_tick_rate;
+        _tick_duration = 1.0 / _tick_rate;
+        _accumulator   = 0.0;
+    }
+
+    // INFO: Adds the time the last frame took and returns how many ticks to run for it
+    std::uint32_t advance(float frame_time)
+    {
+        _accumulator += frame_time;
+
+        std::uint32_t ticks = 0;
+
+        while (_accumulator >= _tick_duration && ticks < _max_ticks_per_frame)
+        {
+            _accumulator -= _tick_duration;
+            ticks++;
+        }
+
+        // NOTE: After a long stall the backlog is dropped, catching up would only make the next frame slower
+        if (_accumulator >= _tick_duration)
+        {
+            _accumulator = std::fmod(_accumulator, _tick_duration);
+        }
+
+        _tick += ticks;
+        return ticks;
+    }
+
+    std::uint32_t tick_rate() const { return _tick_rate; }
+    float tick_time() const { return static_cast<float>(_tick_duration); }
+    float alpha() const { return static_cast<float>(_accumulator / _tick_duration); }
+
+    // INFO: Ticks run since the clock was created
+    std::uint64_t tick() const { return _tick; }
+
+   protected:
+    std::uint32_t _tick_rate           = default_tick_rate;
+    std::uint32_t _max_ticks_per_frame = 8;
+
+    // NOTE: Doubles so the remainder does not drift over long sessions
+    double _tick_duration = 1.0 / default_tick_rate;
+    double _accumulator   = 0.0;
+
+    std::uint64_t _tick = 0;
+};
+
+#endif // SIMULATION_CLOCK_HPP
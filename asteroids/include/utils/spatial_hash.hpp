@@ -0,0 +1,149 @@
+#ifndef SPATIAL_HASH_HPP
+#define SPATIAL_HASH_HPP
+
+#include <raylib.h>
+
+#include <components/physics.hpp>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <utils/playfield.hpp>
+#include <vector>
+
+struct collider_proxy
+{
+    entt::entity entity;
+    Vector2 previous_position;
+    Vector2 position;
+    float radius;
+    collision_filter filter;
+
+    // INFO: Moved far enough this tick to need a sweep from previous_position
+    bool swept;
+
+    Vector2 min;
+    Vector2 max;
+
+    // INFO: 0 for real proxies, otherwise 1 + index into the wrap offsets of this copy
+    std::uint8_t ghost_offset;
+    // INFO: On real proxies, one bit per wrap offset a ghost copy was made for
+    std::uint8_t ghosts;
+};
+
+// INFO: Wrap offsets in units of the playfield size, opposite offsets sit at index 7 - i
+static const std::int8_t wrap_offsets[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+// NOTE: Ghosts only ever pair with real proxies of other entities. A pair across the seam is seen
+// from both sides when both ends got a ghost, only the lower entity's ghost reports it then.
+inline static bool proxy_pair_allowed(const collider_proxy& proxy, const collider_proxy& other_proxy)
+{
+    if (!collision_filter_accepts(proxy.filter, other_proxy.filter))
+        return false;
+
+    if (proxy.ghost_offset == 0 && other_proxy.ghost_offset == 0)
+        return true;
+
+    if (proxy.ghost_offset != 0 && other_proxy.ghost_offset != 0)
+        return false;
+
+    if (proxy.entity == other_proxy.entity)
+        return false;
+
+    const collider_proxy& ghost = proxy.ghost_offset != 0 ? proxy : other_proxy;
+    const collider_proxy& real  = proxy.ghost_offset != 0 ? other_proxy : proxy;
+
+    const std::uint8_t mirrored_ghost = 1u << (7 - (ghost.ghost_offset - 1));
+
+    return (real.ghosts & mirrored_ghost) == 0 || ghost.entity < real.entity;
+}
+
+// INFO: Uniform grid rebuilt every tick. Proxies are bucketed into every cell their
+// bounds overlap, a pair is only reported by the cell that contains the min corner of
+// the intersection of both bounds, so every candidate pair is visited exactly once.
+// Pairs rejected by their collision filters are dropped before any bounds math.
+// Optionally the playfield wraps, proxies close to a seam get ghost copies on the other side.
+class spatial_hash {
+   public:
+    spatial_hash(float cell_size = 64.0f) :
+        _cell_size(cell_size) {}
+
+    void clear();
+    void insert(entt::entity entity, Vector2 previous_position, Vector2 position, float radius, collision_filter filter);
+    // INFO: Call after the last insert and before build
+    void wrap(const playfield& field);
+    void build();
+
+    // INFO: Splits the cells into contiguous ranges holding roughly the same number of entries,
+    // visiting the ranges in order yields the same pairs in the same order as each_pair.
+    void partition(std::uint32_t count, std::vector<std::uint32_t>& bounds) const;
+
+    template<typename Func>
+    void each_pair(Func func) const
+    {
+        each_pair(0, _cell_count, func);
+    }
+
+    template<typename Func>
+    void each_pair(std::uint32_t first_cell, std::uint32_t last_cell, Func func) const
+    {
+        for (std::uint32_t cell = first_cell; cell < last_cell; cell++)
+        {
+            const std::uint32_t first = _cell_start[cell];
+            const std::uint32_t last  = _cell_start[cell + 1];
+
+            for (std::uint32_t i = first; i < last; i++)
+            {
+                const collider_proxy& proxy = _proxies[_cell_entries[i]];
+
+                for (std::uint32_t j = i + 1; j < last; j++)
+                {
+                    const collider_proxy& other_proxy = _proxies[_cell_entries[j]];
+
+                    if (!proxy_pair_allowed(proxy, other_proxy))
+                        continue;
+
+                    if (!owns_pair(cell, proxy, other_proxy))
+                        continue;
+
+                    func(proxy, other_proxy);
+                }
+            }
+        }
+    }
+
+    const std::vector<collider_proxy>& proxies() const { return _proxies; }
+    float cell_size() const { return _cell_size; }
+
+   protected:
+    std::int32_t cell_x(float x) const;
+    std::int32_t cell_y(float y) const;
+
+    bool owns_pair(std::uint32_t cell, const collider_proxy& proxy, const collider_proxy& other_proxy) const
+    {
+        if (proxy.max.x < other_proxy.min.x || other_proxy.max.x < proxy.min.x)
+            return false;
+
+        if (proxy.max.y < other_proxy.min.y || other_proxy.max.y < proxy.min.y)
+            return false;
+
+        const float x = proxy.min.x > other_proxy.min.x ? proxy.min.x : other_proxy.min.x;
+        const float y = proxy.min.y > other_proxy.min.y ? proxy.min.y : other_proxy.min.y;
+
+        return static_cast<std::uint32_t>(cell_y(y) * _columns + cell_x(x)) == cell;
+    }
+
+    float _cell_size;
+    float _inverse_cell_size = 0.0f;
+
+    Vector2 _origin = {0, 0};
+
+    std::int32_t _columns     = 0;
+    std::int32_t _rows        = 0;
+    std::uint32_t _cell_count = 0;
+
+    std::vector<collider_proxy> _proxies;
+    std::vector<std::uint32_t> _cell_start;
+    std::vector<std::uint32_t> _cell_entries;
+    std::vector<std::uint32_t> _cell_cursor;
+};
+
+#endif // SPATIAL_HASH_HPP
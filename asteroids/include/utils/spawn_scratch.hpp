@@ -0,0 +1,21 @@
+#ifndef SPAWN_SCRATCH_HPP
+#define SPAWN_SCRATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+// INFO: Buffer the bulk spawn functions lay out a component range in before handing it to
+// registry.insert. It grows to the largest batch seen and stays there, so spawning in steady
+// state does not allocate.
+// NOTE: One buffer per type, shared by every spawn function and not reentrant. Fill it and insert
+// it before anything else can spawn.
+template<typename Type>
+std::vector<Type>& spawn_scratch(std::size_t count)
+{
+    static std::vector<Type> buffer;
+
+    buffer.resize(count);
+    return buffer;
+}
+
+#endif // SPAWN_SCRATCH_HPP
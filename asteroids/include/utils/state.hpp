@@ -37,6 +37,9 @@ class state {
         _on_exit(on_exit),
         _update(update){};
 
+    // INFO: Print every transition taken, benchmarks turn it off to keep the output clean
+    static inline bool log_transitions = true;
+
     void add_transition(std::function<bool()> condition, std::shared_ptr<state> target_state, const char* name)
     {
         _transitions.push_back(state_transition(condition, target_state, name));
@@ -58,7 +61,10 @@ class state {
             if (!transition.evaluate())
                 continue;
 
-            std::cout << "Transitioning to " << transition.get_name() << std::endl;
+            if (log_transitions)
+            {
+                std::cout << "Transitioning to " << transition.get_name() << std::endl;
+            }
 
             on_exit();
             next_state = transition.target_state();
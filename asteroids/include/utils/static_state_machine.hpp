@@ -0,0 +1,155 @@
+#ifndef STATIC_STATE_MACHINE_HPP
+#define STATIC_STATE_MACHINE_HPP
+
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// INFO: State machine whose states and transitions are types. The current state lives in a
+// std::variant, updating it and checking its transitions is resolved at compile time, so the
+// machine never allocates and copying it copies a few bytes.
+//
+// A state is a default constructible type with update(Context&, float), on_enter(Context&) and
+// on_exit(Context&) are optional. Data a state owns, like a timer, is reset whenever the state is
+// entered. Anything that outlives a state belongs in the context.
+//
+// A guard is a default constructible type with bool operator()(Context&) const. Guards that have
+// a static name are printed when they fire, once static_state_machine_log::log_transitions is set.
+
+template<typename... States>
+struct state_list
+{};
+
+template<typename From, typename To, typename Guard>
+struct transition
+{
+    using from  = From;
+    using to    = To;
+    using guard = Guard;
+};
+
+template<typename... Transitions>
+struct transition_list
+{};
+
+// INFO: Shared by every instantiation. Off by default, printing on every transition costs more
+// than the transition itself, turn it on to follow what the scenes and enemies are doing.
+struct static_state_machine_log
+{
+    static inline bool log_transitions = false;
+};
+
+template<typename Context, typename States, typename Transitions>
+class static_state_machine;
+
+template<typename Context, typename... States, typename... Transitions>
+class static_state_machine<Context, state_list<States...>, transition_list<Transitions...>> {
+   public:
+    // INFO: Starts in the first state of the list, on_enter runs on start
+    static_state_machine() = default;
+
+    void start(Context& context)
+    {
+        std::visit([&context](auto& current_state) { enter(current_state, context); }, _current_state);
+    }
+
+    // INFO: Updates the current state, then takes the first transition out of it whose guard holds
+    void update(Context& context, float delta_time)
+    {
+        std::visit(
+            [this, &context, delta_time](auto& current_state) {
+                current_state.update(context, delta_time);
+
+                using current_type = std::decay_t<decltype(current_state)>;
+                (try_transition<current_type, Transitions>(context) || ...);
+            },
+            _current_state);
+    }
+
+    void stop(Context& context)
+    {
+        std::visit([&context](auto& current_state) { leave(current_state, context); }, _current_state);
+    }
+
+    template<typename State>
+    bool is() const
+    {
+        return std::holds_alternative<State>(_current_state);
+    }
+
+    template<typename State>
+    State& get()
+    {
+        return std::get<State>(_current_state);
+    }
+
+   protected:
+    template<typename State, typename = void>
+    struct has_on_enter : std::false_type
+    {};
+
+    template<typename State>
+    struct has_on_enter<State, std::void_t<decltype(std::declval<State&>().on_enter(std::declval<Context&>()))>> : std::true_type
+    {};
+
+    template<typename State, typename = void>
+    struct has_on_exit : std::false_type
+    {};
+
+    template<typename State>
+    struct has_on_exit<State, std::void_t<decltype(std::declval<State&>().on_exit(std::declval<Context&>()))>> : std::true_type
+    {};
+
+    template<typename Guard, typename = void>
+    struct has_name : std::false_type
+    {};
+
+    template<typename Guard>
+    struct has_name<Guard, std::void_t<decltype(Guard::name)>> : std::true_type
+    {};
+
+    template<typename State>
+    static void enter(State& state, Context& context)
+    {
+        if constexpr (has_on_enter<State>::value)
+            state.on_enter(context);
+    }
+
+    template<typename State>
+    static void leave(State& state, Context& context)
+    {
+        if constexpr (has_on_exit<State>::value)
+            state.on_exit(context);
+    }
+
+    // NOTE: Transitions out of other states compile down to false
+    template<typename Current, typename Transition>
+    bool try_transition(Context& context)
+    {
+        if constexpr (!std::is_same_v<typename Transition::from, Current>)
+        {
+            return false;
+        } else
+        {
+            using guard = typename Transition::guard;
+
+            if (!guard{}(context))
+                return false;
+
+            if constexpr (has_name<guard>::value)
+            {
+                if (static_state_machine_log::log_transitions)
+                    std::printf("Transitioning to %s\n", guard::name);
+            }
+
+            leave(std::get<Current>(_current_state), context);
+            enter(_current_state.template emplace<typename Transition::to>(), context);
+            return true;
+        }
+    }
+
+    std::variant<States...> _current_state;
+};
+
+#endif // STATIC_STATE_MACHINE_HPP
@@ -0,0 +1,48 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <raylib.h>
+
+#include <components/base.hpp>
+#include <entt/entt.hpp>
+#include <memory>
+
+// INFO: Loads through the platform, the texture is unloaded when its last handle goes away
+struct texture_loader
+{
+    using result_type = std::shared_ptr<Texture2D>;
+
+    result_type operator()(const char* path) const;
+    // INFO: Takes over a texture that was already uploaded
+    result_type operator()(Texture2D texture) const;
+};
+
+// INFO: Keyed by the GAME_TEXTURES values
+using texture_cache = entt::resource_cache<Texture2D, texture_loader>;
+
+// INFO: Every texture the game ships with
+static const GAME_TEXTURES game_texture_ids[] = {GAME_TEXTURES::MAINTEXTURE, GAME_TEXTURES::PLANETEXTURE, GAME_TEXTURES::SMOKETEXTURE,
+                                                 GAME_TEXTURES::BULLETTEXTURE_BLUE, GAME_TEXTURES::BULLETTEXTURE_RED};
+
+const char* game_texture_path(GAME_TEXTURES texture_id);
+
+// INFO: Outlives the scenes, so entering one again costs no I/O and no decoding
+texture_cache& get_texture_cache();
+
+// INFO: Loads the texture the first time, after that it is a single lookup in the cache.
+// Scenes load theirs on enter so spawning never hits the disk.
+entt::resource<Texture2D> load_game_texture(GAME_TEXTURES texture_id);
+
+// INFO: Hands a texture uploaded elsewhere to the cache, unloaded again if the id is taken
+void add_game_texture(GAME_TEXTURES texture_id, Texture2D texture);
+bool has_game_texture(GAME_TEXTURES texture_id);
+
+inline Texture2D game_texture(GAME_TEXTURES texture_id)
+{
+    return *load_game_texture(texture_id);
+}
+
+// INFO: Drops the cache's handles, has to run while the window that owns the textures is open
+void unload_game_textures();
+
+#endif // TEXTURE_CACHE_HPP
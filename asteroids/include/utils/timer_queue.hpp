@@ -0,0 +1,75 @@
+#ifndef TIMER_QUEUE_HPP
+#define TIMER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <limits>
+#include <utils/simulation_clock.hpp>
+#include <vector>
+
+// INFO: Callback of a delayed call, bound to a free function so storing it never allocates
+using timer_callback = entt::delegate<void(entt::registry&)>;
+
+// INFO: Min heap of timers keyed by the tick they expire on, in the registry context. Advancing
+// a tick only pops the timers that expire on it, so the cost follows the expirations rather
+// than the number of live timers.
+class timer_queue {
+   public:
+    // INFO: Expiry of a lifetime that never ends, parked prefabs use it
+    static constexpr std::uint64_t never = std::numeric_limits<std::uint64_t>::max();
+
+    static timer_queue& of(entt::registry& registry);
+
+    // INFO: Calls callback after delay seconds
+    void schedule(float delay, timer_callback callback);
+    // INFO: Queues entity for destruction once its lifetime component runs out. Called by the
+    // lifetime hooks whenever the component is emplaced or replaced.
+    void expire(entt::registry& registry, entt::entity entity);
+
+    // INFO: Fires the timers due on the current tick and moves on to the next one, returns how
+    // many fired
+    std::size_t advance(entt::registry& registry, float tick_time);
+
+    std::uint64_t tick() const { return _tick; }
+    std::size_t size() const { return _timers.size(); }
+
+   protected:
+    struct timer
+    {
+        std::uint64_t expiry;
+        // INFO: Order of scheduling, timers due on the same tick fire first come first served
+        std::uint64_t sequence;
+
+        // INFO: Either an entity whose lifetime ends or a callback
+        entt::entity entity;
+        timer_callback callback;
+    };
+
+    struct later
+    {
+        bool operator()(const timer& timer_a, const timer& timer_b) const
+        {
+            return timer_a.expiry != timer_b.expiry ? timer_a.expiry > timer_b.expiry : timer_a.sequence > timer_b.sequence;
+        }
+    };
+
+    std::uint64_t expiry_tick(float delay) const;
+    void push(std::uint64_t expiry, entt::entity entity, timer_callback callback);
+
+    std::vector<timer> _timers;
+
+    std::uint64_t _tick     = 0;
+    std::uint64_t _sequence = 0;
+    // NOTE: Seconds per tick, taken from the last advance. Timers scheduled before the first one
+    // assume the default tick rate.
+    float _tick_time = 1.0f / default_tick_rate;
+};
+
+// INFO: Connected to the lifetime signals, so every way of giving an entity a lifetime schedules it
+inline static void schedule_lifetime(entt::registry& registry, entt::entity entity)
+{
+    timer_queue::of(registry).expire(registry, entity);
+}
+
+#endif // TIMER_QUEUE_HPP
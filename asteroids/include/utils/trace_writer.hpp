@@ -0,0 +1,101 @@
+#ifndef TRACE_WRITER_HPP
+#define TRACE_WRITER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// INFO: Writes scoped zones as Chrome trace event JSON, open the file in Perfetto or
+// chrome://tracing. Enabled at runtime with the ASTEROIDS_TRACE environment variable or the
+// --trace flag, both take the output path. Disabled, a zone costs one branch.
+//
+// NOTE: Zones are recorded from the thread running the scenes only. Events go into a buffer
+// that is handed over to a background thread once full, the frame thread never formats or
+// writes anything itself.
+class trace_writer {
+   public:
+    using clock = std::chrono::steady_clock;
+
+    static trace_writer& instance();
+
+    ~trace_writer();
+
+    trace_writer(const trace_writer&)            = delete;
+    trace_writer& operator=(const trace_writer&) = delete;
+
+    // INFO: Opens path and starts the writer thread, false if the file can not be created
+    bool start(const char* path);
+    // INFO: Starts when ASTEROIDS_TRACE is set, returns whether tracing is on
+    bool start_from_environment();
+    // INFO: Writes everything still buffered and closes the file
+    void stop();
+
+    bool enabled() const { return _enabled; }
+
+    // NOTE: name has to outlive the writer, string literals and entt::type_name values do
+    void write_zone(std::string_view name, clock::time_point start, clock::time_point end);
+
+   protected:
+    trace_writer() = default;
+
+    struct trace_event
+    {
+        std::string_view name;
+        clock::time_point start;
+        clock::time_point end;
+    };
+
+    using event_buffer = std::vector<trace_event>;
+
+    static const std::size_t buffer_capacity = 4096;
+
+    void submit();
+    void writer_loop();
+    void write_events(const event_buffer& events);
+
+    bool _enabled = false;
+
+    std::FILE* _file = nullptr;
+    clock::time_point _epoch;
+
+    std::unique_ptr<event_buffer> _current;
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping = false;
+
+    std::vector<std::unique_ptr<event_buffer>> _full;
+    // INFO: Buffers the writer thread is done with, reused so steady state tracing does not allocate
+    std::vector<std::unique_ptr<event_buffer>> _free;
+};
+
+class scoped_trace_zone {
+   public:
+    scoped_trace_zone(std::string_view name) :
+        _name(name)
+    {
+        if (trace_writer::instance().enabled())
+            _start = trace_writer::clock::now();
+    }
+
+    ~scoped_trace_zone()
+    {
+        if (_start != trace_writer::clock::time_point{})
+            trace_writer::instance().write_zone(_name, _start, trace_writer::clock::now());
+    }
+
+    scoped_trace_zone(const scoped_trace_zone&)            = delete;
+    scoped_trace_zone& operator=(const scoped_trace_zone&) = delete;
+
+   protected:
+    std::string_view _name;
+    trace_writer::clock::time_point _start = {};
+};
+
+#endif // TRACE_WRITER_HPP
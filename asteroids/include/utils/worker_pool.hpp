@@ -0,0 +1,59 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <entt/entt.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// INFO: Fixed set of threads that run indexed tasks in parallel. The calling thread takes
+// part in the work and run() only returns once every task has finished.
+class worker_pool {
+   public:
+    worker_pool(std::size_t thread_count);
+    ~worker_pool();
+
+    worker_pool(const worker_pool&)            = delete;
+    worker_pool& operator=(const worker_pool&) = delete;
+
+    template<typename Func>
+    void run(std::size_t task_count, Func& func)
+    {
+        entt::delegate<void(std::size_t)> task;
+        task.connect([](const void* payload, std::size_t index) {
+            (*static_cast<Func*>(const_cast<void*>(payload)))(index);
+        },
+                     &func);
+
+        run(task_count, task);
+    }
+
+    void run(std::size_t task_count, entt::delegate<void(std::size_t)> task);
+
+    std::size_t thread_count() const { return _threads.size(); }
+
+   protected:
+    void worker_loop();
+    void work(entt::delegate<void(std::size_t)> task, std::size_t task_count);
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    entt::delegate<void(std::size_t)> _task;
+    std::size_t _task_count = 0;
+
+    std::atomic<std::size_t> _next_task{0};
+    std::atomic<std::size_t> _finished_tasks{0};
+
+    std::size_t _generation     = 0;
+    std::size_t _active_workers = 0;
+    bool _stopping              = false;
+};
+
+#endif // WORKER_POOL_HPP
@@ -2,34 +2,92 @@
 #include <raymath.h>
 #include <rlgl.h>
 
+#include <chrono>
 #include <components/player.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <entt/entt.hpp>
 #include <math.hpp>
+#include <platform/null_platform.hpp>
+#include <platform/raylib_platform.hpp>
 #include <processors/physics_processors.hpp>
 #include <processors/render_processors.hpp>
+#include <utils/process_profiler.hpp>
+#include <utils/texture_cache.hpp>
+#include <utils/trace_writer.hpp>
 
 #include "scenes/scene_management.hpp"
-#include "utils/state.hpp"
 
-int main()
+static void run_game_loop()
 {
-    const char* TITLE = "ASTEROIDS";
-    InitWindow(900, 600, TITLE);
-    SetTargetFPS(60);
-
     auto game_machine = create_game_state_machine();
     game_machine.start();
 
-    while (!WindowShouldClose())
+    while (!get_platform().should_close())
     {
-        const float delta_time = GetFrameTime();
+        scoped_trace_zone zone("frame");
+
+        const float delta_time = get_platform().frame_time();
 
         game_machine.update(delta_time);
+
+        profile_next_frame();
     }
 
     game_machine.stop();
 
-    CloseWindow();
+    // INFO: While the window is still open, the textures belong to its context
+    unload_game_textures();
+
+    trace_writer::instance().stop();
+
+    // INFO: Only written when built with ASTEROIDS_PROFILING
+    profile_dump("process_profile.csv");
+}
+
+// INFO: Usage: asteroids [--trace <file>] [--headless <frames>]
+int main(int argc, char** argv)
+{
+    // INFO: The flag wins over ASTEROIDS_TRACE
+    if (argc > 2 && std::strcmp(argv[1], "--trace") == 0)
+    {
+        if (!trace_writer::instance().start(argv[2]))
+            std::fprintf(stderr, "could not open trace file %s\n", argv[2]);
+
+        argc -= 2;
+        argv += 2;
+    } else
+    {
+        trace_writer::instance().start_from_environment();
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--headless") == 0)
+    {
+        const std::uint64_t frames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+
+        null_platform headless(900, 600, 1.0f / 60.0f, frames);
+        set_platform(&headless);
+
+        // INFO: Skip the title screen
+        headless.press_key(KEY_SPACE);
+
+        auto start = std::chrono::steady_clock::now();
+        run_game_loop();
+        auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        std::printf("%llu frames in %.3fs, %.0f frames/s\n", static_cast<unsigned long long>(headless.frame()), seconds, headless.frame() / seconds);
+
+        return 0;
+    }
+
+    const char* TITLE = "ASTEROIDS";
+
+    raylib_platform window(900, 600, TITLE, 60);
+    set_platform(&window);
+
+    run_game_loop();
 
     return 0;
 }
@@ -2,8 +2,17 @@
 
 #include <raylib.h>
 
+#include <algorithm>
+#include <array>
 #include <components/render.hpp>
 #include <iostream>
+#include <platform/platform.hpp>
+#include <utils/destruction_buffer.hpp>
+#include <utils/prefab_pool.hpp>
+#include <utils/spawn_scratch.hpp>
+#include <utils/texture_cache.hpp>
+#include <utils/trace_writer.hpp>
+#include <vector>
 
 #include "components/base.hpp"
 #include "components/physics.hpp"
@@ -13,32 +22,34 @@
 
 entt::entity spawn_smoke_explosion(entt::registry& registry, Vector2 position, int id, float radius, float duration)
 {
+    scoped_trace_zone zone("spawn_smoke_explosion");
+
     if (id < 0 || id >= 11)
         return entt::null;
 
-    static const std::uint32_t texture_tag = static_cast<std::uint32_t>(GAME_TEXTURES::SMOKETEXTURE);
-
-    std::shared_ptr<std::vector<sprite_frame>> frame_sources = std::make_shared<std::vector<sprite_frame>>(11);
-
     const int sprite_size = 64;
-    const int dx          = 64;
-    const int dy          = 64;
 
     const float sprite_size_f = static_cast<float>(sprite_size);
 
     const float scale = radius * 2 / sprite_size_f;
 
-    // OPTIMIZE: How to do this only once?
-    for (int i = 0; i < 11; i++)
+    // PERF: One row of the sheet per id, built on first use and shared by every puff after that
+    static std::array<std::shared_ptr<std::vector<sprite_frame>>, 11> frames_by_id;
+
+    std::shared_ptr<std::vector<sprite_frame>>& frame_sources = frames_by_id[id];
+
+    if (frame_sources == nullptr)
     {
-        frame_sources->at(i) = {
-            {i * sprite_size_f, id * sprite_size_f, sprite_size, sprite_size}};
-    }
+        frame_sources = std::make_shared<std::vector<sprite_frame>>(11);
 
-    auto texture_entity = registry.view<Texture2D, entt::tag<texture_tag>>().front();
-    Texture2D tilesheet = registry.get<Texture2D>(texture_entity);
+        for (int i = 0; i < 11; i++)
+        {
+            frame_sources->at(i) = {
+                {i * sprite_size_f, id * sprite_size_f, sprite_size, sprite_size}};
+        }
+    }
 
-    entt::entity entity = registry.create();
+    Texture2D tilesheet = game_texture(GAME_TEXTURES::SMOKETEXTURE);
 
     sprite_sequence explosion_sequence = {
         .frames              = frame_sources,
@@ -48,37 +59,54 @@ entt::entity spawn_smoke_explosion(entt::registry& registry, Vector2 position, i
         .frame_time          = duration / 11.0f,
     };
 
-    registry.emplace<sprite_render>(entity, sprite_render{tilesheet, frame_sources->at(0).source, scale, WHITE});
+    const sprite_render render_data = sprite_render{tilesheet, frame_sources->at(0).source, scale, WHITE};
+
+    prefab_pools& pools = prefab_pools::of(registry);
+
+    entt::entity entity = entt::null;
+
+    if (pools.acquire(registry, pooled_prefab::SMOKE, &entity, 1) == 1)
+    {
+        assign_components(registry, entity, render_data, explosion_sequence, transform{position, 0}, lifetime{0.2f * 5});
+        return entity;
+    }
+
+    entity = registry.create();
+    pools.created(pooled_prefab::SMOKE, 1);
+
+    registry.emplace<sprite_render>(entity, render_data);
     registry.emplace<sprite_sequence>(entity, explosion_sequence);
     registry.emplace<transform>(entity, transform{position, 0});
-    registry.emplace<lifetime>(entity, lifetime{0.2f * 5, 0});
+    registry.emplace<lifetime>(entity, lifetime{0.2f * 5});
+    registry.emplace<pooled>(entity, pooled{pooled_prefab::SMOKE, true});
 
     return entity;
 }
 
 void spawn_random_start_distribution(entt::registry& registry, int count)
 {
-    const float screenWidth  = GetScreenWidth();
-    const float screenHeight = GetScreenHeight();
+    const float screenWidth  = get_platform().screen_width();
+    const float screenHeight = get_platform().screen_height();
 
-    for (int i = 0; i < count; i++)
-    {
-        float x = GetRandomValue(0, screenWidth);
-        float y = GetRandomValue(0, screenHeight);
+    std::vector<star_spawn> spawns(count);
 
-        float angle = GetRandomValue(15, 345);
-        float speed = GetRandomValue(100, 200);
+    for (auto& spawn : spawns)
+    {
+        float x = get_platform().random_value(0, screenWidth);
+        float y = get_platform().random_value(0, screenHeight);
 
-        Vector2 position = {x, y};
+        float angle = get_platform().random_value(15, 345);
 
-        spawn_star(registry, position, angle);
+        spawn = star_spawn{Vector2{x, y}, angle};
     }
+
+    spawn_stars(registry, spawns.data(), spawns.size());
 };
 
 void spawn_random_asteroid_distribution(entt::registry& registry, int count)
 {
-    const float screenWidth  = GetScreenWidth();
-    const float screenHeight = GetScreenHeight();
+    const float screenWidth  = get_platform().screen_width();
+    const float screenHeight = get_platform().screen_height();
 
     const Rectangle top_rect    = {-40, -40, screenWidth + 40.0f, 40};
     const Rectangle bottom_rect = {-40, screenHeight, screenWidth + 40.0f, 40};
@@ -87,22 +115,26 @@ void spawn_random_asteroid_distribution(entt::registry& registry, int count)
 
     const std::array<Rectangle, 4> rects = {top_rect, bottom_rect, left_rect, right_rect};
 
-    for (int i = 0; i < count; i++)
+    std::vector<asteroid_spawn> spawns(count);
+
+    for (auto& spawn : spawns)
     {
-        int random            = GetRandomValue(0, 3);
+        int random            = get_platform().random_value(0, 3);
         const Rectangle& rect = rects[random];
 
-        float x = GetRandomValue(rect.x, rect.x + rect.width);
-        float y = GetRandomValue(rect.y, rect.y + rect.height);
+        float x = get_platform().random_value(rect.x, rect.x + rect.width);
+        float y = get_platform().random_value(rect.y, rect.y + rect.height);
 
-        float angle = GetRandomValue(15, 345);
-        float speed = GetRandomValue(100, 200);
+        float angle = get_platform().random_value(15, 345);
+        float speed = get_platform().random_value(100, 200);
 
         Vector2 position = {x, y};
         Vector2 velocity = Vector2Normalize(Vector2{cosf(angle * DEG2RAD), sinf(angle * DEG2RAD)}) * speed;
 
-        spawn_asteroid(registry, position, velocity, 3);
+        spawn = asteroid_spawn{position, velocity, 3};
     }
+
+    spawn_asteroids(registry, spawns.data(), spawns.size());
 }
 
 void on_player_score(entt::registry& registry, entt::entity asteroid_entity, Vector2 normalizedDirection, int8_t level)
@@ -163,30 +195,34 @@ void on_asteroid_break(entt::registry& registry, entt::entity asteroid_entity, V
 
     if (level <= 0)
     {
-        registry.emplace<entt::tag<kill_tag>>(asteroid_entity);
+        destroy_deferred(registry, asteroid_entity);
 
         spawn_smoke_explosion(registry, transform_data.position, 8, collision_data.radius * 1.2f, 0.2f);
         return;
     }
 
-    auto generate_asteroid = [&registry, &normalizedDirection, &level](Vector2 position, Vector2 velocity) {
-        float angle          = GetRandomValue(-80, 80);
+    auto generate_asteroid = [&normalizedDirection, &level](Vector2 position, Vector2 velocity) {
+        float angle          = get_platform().random_value(-80, 80);
         auto break_direction = Vector2Rotate(normalizedDirection, angle * DEG2RAD) * 350.0f;
 
         auto speed = Vector2Length(velocity) * 1.5f;
         velocity   = Vector2Normalize(break_direction) * speed;
 
-        spawn_asteroid(registry, position, velocity, level);
+        return asteroid_spawn{position, velocity, level};
     };
 
     auto physics_data = registry.get<physics>(asteroid_entity);
 
     spawn_smoke_explosion(registry, transform_data.position, 2, collision_data.radius * 1.5f, 0.5f);
 
-    registry.emplace<entt::tag<kill_tag>>(asteroid_entity);
+    destroy_deferred(registry, asteroid_entity);
 
-    generate_asteroid(transform_data.position, physics_data.velocity);
-    generate_asteroid(transform_data.position, physics_data.velocity);
+    const asteroid_spawn fragments[] = {
+        generate_asteroid(transform_data.position, physics_data.velocity),
+        generate_asteroid(transform_data.position, physics_data.velocity),
+    };
+
+    spawn_asteroids(registry, fragments, 2);
 }
 
 void on_asteroid_collision(entt::registry& registry, entt::entity asteroid_entity, entt::entity other_entity)
@@ -205,116 +241,194 @@ void on_asteroid_collision(entt::registry& registry, entt::entity asteroid_entit
     if (asteroid_team == other_team)
         return;
 
-    if (registry.valid(other_entity))
-    {
-        asteroid_responder_data.on_collision(registry, asteroid_entity, other_entity);
-    }
+    asteroid_responder_data.on_collision(registry, asteroid_entity, other_entity);
 }
 
-entt::entity spawn_star(entt::registry& registry, Vector2 position, float angle)
+static Color random_star_color()
 {
-    static const auto random_color = []() {
-        static const std::array<Color, 5> colors = {
-            Color{25, 25, 25, 255},
-            Color{50, 50, 50, 255},
-            Color{75, 75, 75, 255},
-        };
-
-        return colors[GetRandomValue(0, 2)];
+    static const std::array<Color, 3> colors = {
+        Color{25, 25, 25, 255},
+        Color{50, 50, 50, 255},
+        Color{75, 75, 75, 255},
     };
 
-    static const std::uint32_t texture_tag = static_cast<std::uint32_t>(GAME_TEXTURES::MAINTEXTURE);
+    return colors[get_platform().random_value(0, 2)];
+}
+
+void spawn_stars(entt::registry& registry, const star_spawn* spawns, std::size_t count, entt::entity* created)
+{
+    if (count == 0)
+        return;
+
+    const float sprite_size = 32;
+    const float scale       = 3 * 2 / sprite_size;
+    const Rectangle source  = Rectangle{944, 432, sprite_size, sprite_size};
+
+    Texture2D tilesheet = game_texture(GAME_TEXTURES::MAINTEXTURE);
+
+    auto& entities = spawn_scratch<entt::entity>(count);
+    registry.create(entities.begin(), entities.end());
 
-    entt::entity entity = registry.create();
+    auto& transforms = spawn_scratch<transform>(count);
+    auto& sprites    = spawn_scratch<sprite_render>(count);
 
-    registry.emplace<transform>(entity, transform{position, angle});
+    for (std::size_t i = 0; i < count; i++)
+    {
+        transforms[i] = transform{spawns[i].position, spawns[i].angle};
+        sprites[i]    = sprite_render{tilesheet, source, scale, random_star_color()};
+
+        if (created != nullptr)
+            created[i] = entities[i];
+    }
 
-    float sprite_size = 32;
-    float scale       = 3 * 2 / sprite_size;
-    Rectangle source  = Rectangle{944, 432, sprite_size, sprite_size};
+    registry.insert<transform>(entities.begin(), entities.end(), transforms.begin());
+    registry.insert<sprite_render>(entities.begin(), entities.end(), sprites.begin());
+}
 
-    auto texture_entity = registry.view<Texture2D, entt::tag<texture_tag>>().front();
-    Texture2D tilesheet = registry.get<Texture2D>(texture_entity);
+entt::entity spawn_star(entt::registry& registry, Vector2 position, float angle)
+{
+    const star_spawn spawn = {position, angle};
 
-    registry.emplace<sprite_render>(entity, sprite_render{tilesheet, source, scale, random_color()});
+    entt::entity entity = entt::null;
+    spawn_stars(registry, &spawn, 1, &entity);
 
     return entity;
 }
+
 static std::unique_ptr<float> a_radius_2_ptr = std::make_unique<float>(50.0f);
 static std::unique_ptr<float> a_radius_1_ptr = std::make_unique<float>(25.0f);
 static std::unique_ptr<float> a_radius_0_ptr = std::make_unique<float>(10.0f);
-entt::entity spawn_asteroid(entt::registry& registry, Vector2 position, Vector2 velocity, int8_t level)
-{
-    static const auto make_rectangle_source = [](int8_t level, float sprite_size) {
-        if (level >= 3)
-        {
-            return Rectangle{16, 528, sprite_size, sprite_size};
-        } else
-        {
-            return Rectangle{160, 544, sprite_size, sprite_size};
-        }
-    };
 
-    static const auto level_radius = [](int8_t level) {
-        if (level >= 3)
-        {
-            return a_radius_2_ptr.get();
-        } else if (level >= 2)
-        {
-            return a_radius_1_ptr.get();
-        } else
-        {
-            return a_radius_0_ptr.get();
-        }
-    };
+static Rectangle asteroid_source(int8_t level, float sprite_size)
+{
+    if (level >= 3)
+    {
+        return Rectangle{16, 528, sprite_size, sprite_size};
+    } else
+    {
+        return Rectangle{160, 544, sprite_size, sprite_size};
+    }
+}
 
-    static const auto random_color = []() {
-        static const std::array<Color, 5> colors = {
-            Color{224, 229, 231, 255},
-            Color{220, 222, 227, 255},
-            Color{233, 238, 240, 255},
-        };
+static float* asteroid_radius(int8_t level)
+{
+    if (level >= 3)
+    {
+        return a_radius_2_ptr.get();
+    } else if (level >= 2)
+    {
+        return a_radius_1_ptr.get();
+    } else
+    {
+        return a_radius_0_ptr.get();
+    }
+}
 
-        return colors[GetRandomValue(0, 2)];
+static Color random_asteroid_color()
+{
+    static const std::array<Color, 3> colors = {
+        Color{224, 229, 231, 255},
+        Color{220, 222, 227, 255},
+        Color{233, 238, 240, 255},
     };
 
-    static const std::uint32_t texture_tag = static_cast<std::uint32_t>(GAME_TEXTURES::MAINTEXTURE);
+    return colors[get_platform().random_value(0, 2)];
+}
 
-    if (level <= 0)
+void spawn_asteroids(entt::registry& registry, const asteroid_spawn* spawns, std::size_t count, entt::entity* created)
+{
+    scoped_trace_zone zone("spawn_asteroids");
+
+    // INFO: Level 0 asteroids do not exist, those spawns come back as entt::null
+    std::size_t spawn_count = 0;
+    for (std::size_t i = 0; i < count; i++)
     {
-        return entt::null;
+        spawn_count += spawns[i].level > 0 ? 1 : 0;
     }
 
-    entt::entity entity = registry.create();
-    float angle         = atan2(velocity.y, velocity.x) * RAD2DEG;
-    auto radius         = level_radius(level);
-
-    asteroid asteroid_data;
-    asteroid_data.level = level;
-    asteroid_data.on_asteroid_death.connect<&on_asteroid_break>();
+    if (spawn_count == 0)
+    {
+        if (created != nullptr)
+            std::fill_n(created, count, entt::null);
 
-    registry.emplace<transform>(entity, transform{position, angle});
-    registry.emplace<physics>(entity, physics{velocity, 0, 0.0f, Vector2{0, 0}, Vector2{0, 0}});
-    registry.emplace<asteroid>(entity, asteroid_data);
+        return;
+    }
 
-    circle_collider asteroid_collider;
-    asteroid_collider.radius = *radius;
-    asteroid_collider.on_collision.connect<&on_asteroid_collision>();
-    registry.emplace<circle_collider>(entity, asteroid_collider);
+    Texture2D tilesheet = game_texture(GAME_TEXTURES::MAINTEXTURE);
 
-    float sprite_size = level < 3 ? 64 : 96;
-    float scale       = asteroid_collider.radius * 2 / sprite_size;
-    Rectangle source  = make_rectangle_source(level, sprite_size);
+    // INFO: Everything that does not depend on the spawn parameters is built once
+    asteroid asteroid_template;
+    asteroid_template.on_asteroid_death.connect<&on_asteroid_break>();
 
-    auto texture_entity = registry.view<Texture2D, entt::tag<texture_tag>>().front();
-    Texture2D tilesheet = registry.get<Texture2D>(texture_entity);
+    circle_collider collider_template;
+    collider_template.on_collision.connect<&on_asteroid_collision>();
 
     bullet_collision_response bullet_responder;
     bullet_responder.on_collision.connect<&on_asteroid_break_by_bullet>();
-    registry.emplace<bullet_collision_response>(entity, bullet_responder);
 
-    registry.emplace<sprite_render>(entity, sprite_render{tilesheet, source, scale, random_color()});
-    registry.emplace<team>(entity, team::ENEMY);
+    auto& entities = spawn_scratch<entt::entity>(spawn_count);
+    registry.create(entities.begin(), entities.end());
+
+    auto& transforms = spawn_scratch<transform>(spawn_count);
+    auto& bodies     = spawn_scratch<physics>(spawn_count);
+    auto& asteroids  = spawn_scratch<asteroid>(spawn_count);
+    auto& colliders  = spawn_scratch<circle_collider>(spawn_count);
+    auto& sprites    = spawn_scratch<sprite_render>(spawn_count);
+
+    std::size_t next = 0;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const asteroid_spawn& spawn = spawns[i];
+
+        if (spawn.level <= 0)
+        {
+            if (created != nullptr)
+                created[i] = entt::null;
+
+            continue;
+        }
+
+        const std::size_t index = next++;
+
+        const float angle = atan2(spawn.velocity.y, spawn.velocity.x) * RAD2DEG;
+
+        transforms[index] = transform{spawn.position, angle};
+        bodies[index]     = physics{spawn.velocity, 0, 0.0f, Vector2{0, 0}, Vector2{0, 0}};
+
+        asteroids[index]       = asteroid_template;
+        asteroids[index].level = spawn.level;
+
+        colliders[index]        = collider_template;
+        colliders[index].radius = *asteroid_radius(spawn.level);
+
+        const float sprite_size = spawn.level < 3 ? 64 : 96;
+        const float scale       = colliders[index].radius * 2 / sprite_size;
+
+        sprites[index] = sprite_render{tilesheet, asteroid_source(spawn.level, sprite_size), scale, random_asteroid_color()};
+
+        if (created != nullptr)
+            created[i] = entities[index];
+    }
+
+    registry.insert<transform>(entities.begin(), entities.end(), transforms.begin());
+    registry.insert<physics>(entities.begin(), entities.end(), bodies.begin());
+    registry.insert<asteroid>(entities.begin(), entities.end(), asteroids.begin());
+    registry.insert<circle_collider>(entities.begin(), entities.end(), colliders.begin());
+    registry.insert<collision_filter>(entities.begin(), entities.end(), make_collision_filter(team::ENEMY, collider_role::ASTEROID));
+    registry.insert<bullet_collision_response>(entities.begin(), entities.end(), bullet_responder);
+    registry.insert<sprite_render>(entities.begin(), entities.end(), sprites.begin());
+    registry.insert<team>(entities.begin(), entities.end(), team::ENEMY);
+}
+
+entt::entity spawn_asteroid(entt::registry& registry, Vector2 position, Vector2 velocity, int8_t level)
+{
+    scoped_trace_zone zone("spawn_asteroid");
+
+    const asteroid_spawn spawn = {position, velocity, level};
+
+    entt::entity entity = entt::null;
+    spawn_asteroids(registry, &spawn, 1, &entity);
 
     return entity;
 }
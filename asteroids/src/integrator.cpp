@@ -0,0 +1,214 @@
+#include <integrator.hpp>
+
+#include <raymath.h>
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ASTEROIDS_INTEGRATOR_SSE
+#    include <xmmintrin.h>
+#endif
+
+float drag_decay(float drag, float delta_time)
+{
+    if (drag <= 0.0f)
+        return 1.0f;
+
+    if (drag >= 1.0f)
+        return 0.0f;
+
+    return std::exp(std::log1p(-drag) * drag_reference_rate * delta_time);
+}
+
+// PERF: Bodies share a handful of drag values, remembering the last one keeps exp out of the loop
+struct drag_decay_cache
+{
+    float delta_time;
+
+    float drag   = -1.0f;
+    float factor = 1.0f;
+
+    float operator()(float body_drag)
+    {
+        // NOTE: Most bodies have no drag at all, keep them from evicting the cached value
+        if (body_drag <= 0.0f)
+            return 1.0f;
+
+        if (body_drag != drag)
+        {
+            drag   = body_drag;
+            factor = drag_decay(body_drag, delta_time);
+        }
+
+        return factor;
+    }
+};
+
+// INFO: Semi-implicit Euler moves with the new velocity, velocity Verlet moves with the old
+// velocity plus the acceleration term. Drag only ever scales the velocity.
+template<physics_integrator integrator>
+static inline void integrate_body(transform& transform_data, physics& physics_data, float delta_time, float half_delta_time_sqr, float decay)
+{
+    const Vector2 acceleration = physics_data.external_impulse;
+
+    Vector2 displacement;
+    if constexpr (integrator == physics_integrator::VERLET)
+    {
+        displacement = Vector2Add(Vector2Scale(physics_data.velocity, delta_time), Vector2Scale(acceleration, half_delta_time_sqr));
+    }
+
+    physics_data.velocity = Vector2Scale(Vector2Add(physics_data.velocity, Vector2Scale(acceleration, delta_time)), decay);
+
+    if constexpr (integrator == physics_integrator::SEMI_IMPLICIT_EULER)
+    {
+        displacement = Vector2Scale(physics_data.velocity, delta_time);
+    }
+
+    transform_data.position = Vector2Add(transform_data.position, displacement);
+    transform_data.rotation = transform_data.rotation + physics_data.angular_velocity * delta_time;
+
+    physics_data.external_impulse = Vector2{0, 0};
+}
+
+template<physics_integrator integrator>
+static void integrate_bodies_scalar(transform* transforms, physics* bodies, std::size_t count, float delta_time)
+{
+    const float half_delta_time_sqr = 0.5f * delta_time * delta_time;
+    drag_decay_cache decay{delta_time};
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        integrate_body<integrator>(transforms[i], bodies[i], delta_time, half_delta_time_sqr, decay(bodies[i].drag));
+    }
+}
+
+void integrate_bodies_scalar(transform* transforms, physics* bodies, std::size_t count, float delta_time, physics_integrator integrator)
+{
+    switch (integrator)
+    {
+        case physics_integrator::SEMI_IMPLICIT_EULER:
+            integrate_bodies_scalar<physics_integrator::SEMI_IMPLICIT_EULER>(transforms, bodies, count, delta_time);
+            break;
+        case physics_integrator::VERLET:
+            integrate_bodies_scalar<physics_integrator::VERLET>(transforms, bodies, count, delta_time);
+            break;
+    }
+}
+
+#ifdef ASTEROIDS_INTEGRATOR_SSE
+
+// NOTE: The kernel reads the components as raw floats, keep it in sync with their layout
+static_assert(sizeof(transform) == 3 * sizeof(float));
+static_assert(offsetof(transform, position) == 0 && offsetof(transform, rotation) == 8);
+static_assert(sizeof(physics) == 8 * sizeof(float));
+static_assert(offsetof(physics, velocity) == 0 && offsetof(physics, angular_velocity) == 8 && offsetof(physics, drag) == 12);
+static_assert(offsetof(physics, external_force) == 16 && offsetof(physics, external_impulse) == 24);
+
+// INFO: Four bodies per step. The AoS components are transposed into registers holding one field
+// of four bodies each, integrated, and transposed back.
+template<physics_integrator integrator>
+static void integrate_bodies_sse(transform* transforms, physics* bodies, std::size_t count, float delta_time)
+{
+    const __m128 dt                  = _mm_set1_ps(delta_time);
+    const __m128 half_delta_time_sqr = _mm_set1_ps(0.5f * delta_time * delta_time);
+    const __m128 zero                = _mm_setzero_ps();
+
+    drag_decay_cache decay{delta_time};
+
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        float* body = reinterpret_cast<float*>(bodies + i);
+        float* pose = reinterpret_cast<float*>(transforms + i);
+
+        __m128 velocity_x = _mm_loadu_ps(body + 0);
+        __m128 velocity_y = _mm_loadu_ps(body + 8);
+        __m128 angular    = _mm_loadu_ps(body + 16);
+        __m128 drag       = _mm_loadu_ps(body + 24);
+        _MM_TRANSPOSE4_PS(velocity_x, velocity_y, angular, drag);
+
+        __m128 force_x   = _mm_loadu_ps(body + 4);
+        __m128 force_y   = _mm_loadu_ps(body + 12);
+        __m128 impulse_x = _mm_loadu_ps(body + 20);
+        __m128 impulse_y = _mm_loadu_ps(body + 28);
+        _MM_TRANSPOSE4_PS(force_x, force_y, impulse_x, impulse_y);
+
+        const __m128 drag_factor = _mm_setr_ps(decay(body[3]), decay(body[11]), decay(body[19]), decay(body[27]));
+
+        __m128 delta_x;
+        __m128 delta_y;
+        if constexpr (integrator == physics_integrator::VERLET)
+        {
+            delta_x = _mm_add_ps(_mm_mul_ps(velocity_x, dt), _mm_mul_ps(impulse_x, half_delta_time_sqr));
+            delta_y = _mm_add_ps(_mm_mul_ps(velocity_y, dt), _mm_mul_ps(impulse_y, half_delta_time_sqr));
+        }
+
+        velocity_x = _mm_mul_ps(_mm_add_ps(velocity_x, _mm_mul_ps(impulse_x, dt)), drag_factor);
+        velocity_y = _mm_mul_ps(_mm_add_ps(velocity_y, _mm_mul_ps(impulse_y, dt)), drag_factor);
+
+        if constexpr (integrator == physics_integrator::SEMI_IMPLICIT_EULER)
+        {
+            delta_x = _mm_mul_ps(velocity_x, dt);
+            delta_y = _mm_mul_ps(velocity_y, dt);
+        }
+
+        __m128 delta_rotation = _mm_mul_ps(angular, dt);
+        __m128 delta_unused   = zero;
+
+        _MM_TRANSPOSE4_PS(velocity_x, velocity_y, angular, drag);
+        _mm_storeu_ps(body + 0, velocity_x);
+        _mm_storeu_ps(body + 8, velocity_y);
+        _mm_storeu_ps(body + 16, angular);
+        _mm_storeu_ps(body + 24, drag);
+
+        impulse_x = zero;
+        impulse_y = zero;
+        _MM_TRANSPOSE4_PS(force_x, force_y, impulse_x, impulse_y);
+        _mm_storeu_ps(body + 4, force_x);
+        _mm_storeu_ps(body + 12, force_y);
+        _mm_storeu_ps(body + 20, impulse_x);
+        _mm_storeu_ps(body + 28, impulse_y);
+
+        // INFO: Four transforms are twelve packed floats, rebuild the deltas in that same pattern
+        _MM_TRANSPOSE4_PS(delta_x, delta_y, delta_rotation, delta_unused);
+
+        const __m128 joint_01 = _mm_shuffle_ps(delta_x, delta_y, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m128 joint_23 = _mm_shuffle_ps(delta_rotation, delta_unused, _MM_SHUFFLE(0, 0, 2, 2));
+
+        const __m128 pose_delta_0 = _mm_shuffle_ps(delta_x, joint_01, _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 pose_delta_1 = _mm_shuffle_ps(delta_y, delta_rotation, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m128 pose_delta_2 = _mm_shuffle_ps(joint_23, delta_unused, _MM_SHUFFLE(2, 1, 2, 0));
+
+        _mm_storeu_ps(pose + 0, _mm_add_ps(_mm_loadu_ps(pose + 0), pose_delta_0));
+        _mm_storeu_ps(pose + 4, _mm_add_ps(_mm_loadu_ps(pose + 4), pose_delta_1));
+        _mm_storeu_ps(pose + 8, _mm_add_ps(_mm_loadu_ps(pose + 8), pose_delta_2));
+    }
+}
+
+#endif
+
+template<physics_integrator integrator>
+static void integrate_bodies(transform* transforms, physics* bodies, std::size_t count, float delta_time)
+{
+    std::size_t done = 0;
+
+#ifdef ASTEROIDS_INTEGRATOR_SSE
+    done = count & ~std::size_t{3};
+    integrate_bodies_sse<integrator>(transforms, bodies, done, delta_time);
+#endif
+
+    integrate_bodies_scalar<integrator>(transforms + done, bodies + done, count - done, delta_time);
+}
+
+void integrate_bodies(transform* transforms, physics* bodies, std::size_t count, float delta_time, physics_integrator integrator)
+{
+    switch (integrator)
+    {
+        case physics_integrator::SEMI_IMPLICIT_EULER:
+            integrate_bodies<physics_integrator::SEMI_IMPLICIT_EULER>(transforms, bodies, count, delta_time);
+            break;
+        case physics_integrator::VERLET:
+            integrate_bodies<physics_integrator::VERLET>(transforms, bodies, count, delta_time);
+            break;
+    }
+}
@@ -0,0 +1,93 @@
+#include <platform/null_platform.hpp>
+
+#include <utility>
+
+// NOTE: xorshift32 gets stuck on a zero state
+static const std::uint32_t default_random_state = 0x9e3779b9u;
+
+null_platform::null_platform(int width, int height, float frame_time, std::uint64_t frame_limit) :
+    _width(width),
+    _height(height),
+    _frame_time(frame_time),
+    _frame_limit(frame_limit),
+    _random_state(default_random_state)
+{
+}
+
+bool null_platform::should_close()
+{
+    // INFO: Same point raylib polls its input events at, so presses line up with a real frame
+    _keys_pressed = _keys_pending;
+    _keys_pending = {};
+
+    if (_frame_limit != 0 && _frame >= _frame_limit)
+        return true;
+
+    _frame++;
+    return false;
+}
+
+// INFO: Reproducible across compilers and standard libraries, unlike the std distributions
+int null_platform::random_value(int min, int max)
+{
+    if (min > max)
+        std::swap(min, max);
+
+    _random_state ^= _random_state << 13;
+    _random_state ^= _random_state >> 17;
+    _random_state ^= _random_state << 5;
+
+    const std::uint32_t range = static_cast<std::uint32_t>(max - min) + 1;
+
+    return min + static_cast<int>(range == 0 ? _random_state : _random_state % range);
+}
+
+void null_platform::set_random_seed(unsigned int seed)
+{
+    _random_state = seed != 0 ? seed : default_random_state;
+}
+
+Texture2D null_platform::load_texture(const char* path)
+{
+    // INFO: id 0 marks the texture as not ready, the render processes skip it
+    return Texture2D{0, 0, 0, 0, 0};
+}
+
+bool null_platform::is_key_down(int key) const
+{
+    return key >= 0 && key < key_count && _keys_down[key];
+}
+
+bool null_platform::is_key_pressed(int key) const
+{
+    return key >= 0 && key < key_count && _keys_pressed[key];
+}
+
+bool null_platform::is_mouse_button_down(int button) const
+{
+    return button >= 0 && button < mouse_button_count && _buttons_down[button];
+}
+
+void null_platform::set_key_down(int key, bool down)
+{
+    if (key < 0 || key >= key_count)
+        return;
+
+    _keys_down[key] = down;
+}
+
+void null_platform::press_key(int key)
+{
+    if (key < 0 || key >= key_count)
+        return;
+
+    _keys_pending[key] = true;
+}
+
+void null_platform::set_mouse_button_down(int button, bool down)
+{
+    if (button < 0 || button >= mouse_button_count)
+        return;
+
+    _buttons_down[button] = down;
+}
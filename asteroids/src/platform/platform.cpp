@@ -0,0 +1,16 @@
+#include <platform/platform.hpp>
+
+#include <cassert>
+
+static platform* current_platform = nullptr;
+
+platform& get_platform()
+{
+    assert(current_platform != nullptr && "set_platform has to be called before the game starts");
+    return *current_platform;
+}
+
+void set_platform(platform* instance)
+{
+    current_platform = instance;
+}
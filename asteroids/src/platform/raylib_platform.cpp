@@ -0,0 +1,118 @@
+#include <platform/raylib_platform.hpp>
+
+#include <utils/trace_writer.hpp>
+
+raylib_platform::raylib_platform(int width, int height, const char* title, int target_fps, unsigned int config_flags)
+{
+    SetConfigFlags(config_flags);
+    InitWindow(width, height, title);
+    SetTargetFPS(target_fps);
+}
+
+raylib_platform::~raylib_platform()
+{
+    CloseWindow();
+}
+
+bool raylib_platform::should_close()
+{
+    return WindowShouldClose();
+}
+
+float raylib_platform::frame_time() const
+{
+    return GetFrameTime();
+}
+
+int raylib_platform::screen_width() const
+{
+    return GetScreenWidth();
+}
+
+int raylib_platform::screen_height() const
+{
+    return GetScreenHeight();
+}
+
+int raylib_platform::random_value(int min, int max)
+{
+    return GetRandomValue(min, max);
+}
+
+void raylib_platform::set_random_seed(unsigned int seed)
+{
+    SetRandomSeed(seed);
+}
+
+Texture2D raylib_platform::load_texture(const char* path)
+{
+    return LoadTexture(path);
+}
+
+void raylib_platform::unload_texture(Texture2D texture)
+{
+    UnloadTexture(texture);
+}
+
+Image raylib_platform::decode_image(const char* path)
+{
+    return LoadImage(path);
+}
+
+Texture2D raylib_platform::upload_texture(Image image)
+{
+    Texture2D texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    return texture;
+}
+
+void raylib_platform::unload_image(Image image)
+{
+    UnloadImage(image);
+}
+
+Texture2D raylib_platform::upload_pixels(const void* pixels, int width, int height)
+{
+    // NOTE: The image only borrows the pixels, LoadTextureFromImage reads them straight into
+    // the GPU upload and never frees them
+    const Image image = {const_cast<void*>(pixels), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+
+    return LoadTextureFromImage(image);
+}
+
+bool raylib_platform::is_key_down(int key) const
+{
+    return IsKeyDown(key);
+}
+
+bool raylib_platform::is_key_pressed(int key) const
+{
+    return IsKeyPressed(key);
+}
+
+bool raylib_platform::is_mouse_button_down(int button) const
+{
+    return IsMouseButtonDown(button);
+}
+
+Vector2 raylib_platform::mouse_position() const
+{
+    return GetMousePosition();
+}
+
+bool raylib_platform::begin_drawing()
+{
+    scoped_trace_zone zone("BeginDrawing");
+
+    BeginDrawing();
+    return true;
+}
+
+void raylib_platform::end_drawing()
+{
+    // INFO: Includes the buffer swap and the wait for the frame limit or vsync
+    scoped_trace_zone zone("EndDrawing");
+
+    EndDrawing();
+}
@@ -2,15 +2,21 @@
 
 #include <raylib.h>
 
+#include <algorithm>
 #include <components/base.hpp>
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
-#include <iomanip>
 #include <iostream>
 #include <math.hpp>
 #include <memory>
-#include <sstream>
+#include <platform/platform.hpp>
+#include <utils/destruction_buffer.hpp>
+#include <utils/prefab_pool.hpp>
+#include <utils/spawn_scratch.hpp>
+#include <utils/texture_cache.hpp>
+#include <utils/timer_queue.hpp>
+#include <utils/trace_writer.hpp>
 #include <vector>
 
 #include "components/physics.hpp"
@@ -18,46 +24,38 @@
 #include "raylib.h"
 #include "scenes/scene_management.hpp"
 
+static void respawn_player(entt::registry& registry)
+{
+    create_player(registry, 0);
+}
+
 void on_player_explosion(entt::registry& registry, entt::entity player_entity, entt::entity other_entity)
 {
     auto trail_view = registry.view<entt::tag<player_trail_tag>>();
 
     for (auto trail_entity : trail_view)
     {
-        registry.emplace<entt::tag<kill_tag>>(trail_entity);
+        destroy_deferred(registry, trail_entity);
     }
 
-    auto player_physics   = registry.get<physics>(player_entity);
     auto player_transform = registry.get<transform>(player_entity);
 
-    if (registry.valid(player_entity))
-    {
-        auto player_data_entry = registry.view<Player>().front();
-
-        auto& player_data = registry.get<Player>(player_data_entry);
-        player_data.lives -= 1;
+    auto player_data_entry = registry.view<Player>().front();
 
-        Player player_data_copy = player_data;
+    auto& player_data = registry.get<Player>(player_data_entry);
+    player_data.lives -= 1;
 
-        registry.emplace<entt::tag<kill_tag>>(player_entity);
-        spawn_explosion(registry, player_transform.position, 3);
+    destroy_deferred(registry, player_entity);
+    spawn_explosion(registry, player_transform.position, 3);
 
-        if (player_data.lives <= 0)
-        {
-            spawn_game_over(registry);
-
-            return;
-        }
-
-        lifetime restore_cooldown;
-        restore_cooldown.lifetime = 3;
-        restore_cooldown.on_end   = [](entt::registry& registry) {
-            create_player(registry, 0);
-        };
+    if (player_data.lives <= 0)
+    {
+        spawn_game_over(registry);
 
-        auto restore_player_entity = registry.create();
-        registry.emplace<lifetime>(restore_player_entity, restore_cooldown);
+        return;
     }
+
+    timer_queue::of(registry).schedule(3, timer_callback{entt::connect_arg<&respawn_player>});
 }
 
 void on_player_collision_with_object(entt::registry& registry, entt::entity other_entity, entt::entity player_entity)
@@ -67,11 +65,10 @@ void on_player_collision_with_object(entt::registry& registry, entt::entity othe
 
 entt::entity create_player(entt::registry& registry, uint8_t id)
 {
-    static const std::uint32_t texture_tag = static_cast<std::uint32_t>(GAME_TEXTURES::MAINTEXTURE);
-    entt::entity entity                    = registry.create();
+    entt::entity entity = registry.create();
 
-    int screenWidth  = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+    int screenWidth  = get_platform().screen_width();
+    int screenHeight = get_platform().screen_height();
 
     circle_collider player_collider;
     player_collider.radius = 10;
@@ -83,6 +80,7 @@ entt::entity create_player(entt::registry& registry, uint8_t id)
             0});
     registry.emplace<physics>(entity, physics{Vector2{0, 0}, 0, 0.005f, Vector2{0, 0}, Vector2{0, 0}});
     registry.emplace<circle_collider>(entity, player_collider);
+    registry.emplace<collision_filter>(entity, make_collision_filter(team::PLAYER, collider_role::SHIP));
     registry.emplace<entt::tag<player_tag>>(entity);
     registry.emplace<team>(entity, team::PLAYER);
 
@@ -116,8 +114,7 @@ entt::entity create_player(entt::registry& registry, uint8_t id)
     float scale  = player_collider.radius * 2 / 96.0f;
     float scale2 = player_collider.radius * 2 / 64.0f;
 
-    auto texture_entity = registry.view<Texture2D, entt::tag<texture_tag>>().front();
-    Texture2D tilesheet = registry.get<Texture2D>(texture_entity);
+    Texture2D tilesheet = game_texture(GAME_TEXTURES::MAINTEXTURE);
 
     registry.emplace<sprite_render>(entity, sprite_render{tilesheet, Rectangle{528, 16, 96, 96}, scale});
     // registry.emplace<sprite_render>(entity, sprite_render{tilesheet, Rectangle{800, 640, 64, 124}, scale2});
@@ -159,80 +156,107 @@ void on_bullet_collision(entt::registry& registry, entt::entity bullet_entity, e
     if (bullet_team == other_team)
         return;
 
-    if (registry.valid(other_entity))
-    {
-        bullet_responder_data.on_collision(registry, bullet_entity, other_entity);
-    }
+    bullet_responder_data.on_collision(registry, bullet_entity, other_entity);
 
-    if (registry.valid(bullet_entity))
-    {
-        registry.emplace<entt::tag<kill_tag>>(bullet_entity);
-    }
+    destroy_deferred(registry, bullet_entity);
 }
 
 static std::unique_ptr<float> radius_ptr = std::make_unique<float>(1.5f);
 
-entt::entity spawn_bullet(entt::registry& registry, Vector2 position, Vector2 velocity, const team& bullet_team)
+void spawn_bullets(entt::registry& registry, const bullet_spawn* spawns, std::size_t count, entt::entity* created)
 {
-    static const std::uint32_t blue_texture_tag = static_cast<std::uint32_t>(GAME_TEXTURES::BULLETTEXTURE_BLUE);
-    static const std::uint32_t red_texture_tag  = static_cast<std::uint32_t>(GAME_TEXTURES::BULLETTEXTURE_RED);
-
     static std::shared_ptr<std::vector<sprite_frame>> frames =
         std::make_shared<std::vector<sprite_frame>>(std::initializer_list<sprite_frame>{{Rectangle{256, 96, 16, 16}},
                                                                                         {Rectangle{272, 96, 16, 16}},
                                                                                         {Rectangle{288, 96, 16, 16}},
                                                                                         {Rectangle{304, 96, 16, 16}}});
 
-    entt::entity entity = registry.create();
-    float angle         = atan2(velocity.y, velocity.x) * RAD2DEG;
+    scoped_trace_zone zone("spawn_bullets");
+
+    if (count == 0)
+        return;
 
-    registry.emplace<transform>(entity, transform{position, angle});
-    registry.emplace<physics>(entity, physics{velocity, 0, 0.0f, Vector2{0, 0}, Vector2{0, 0}});
-    // registry.emplace<shape_render>(entity, render_data);
-    registry.emplace<lifetime>(entity, lifetime{2.5f, 0});
+    const Texture2D blue_tilesheet = game_texture(GAME_TEXTURES::BULLETTEXTURE_BLUE);
+    const Texture2D red_tilesheet  = game_texture(GAME_TEXTURES::BULLETTEXTURE_RED);
 
     circle_collider bullet_collider;
-    bullet_collider.radius = 3.5f;
+    bullet_collider.radius     = 3.5f;
+    bullet_collider.continuous = true;
     bullet_collider.on_collision.connect<&on_bullet_collision>();
-    registry.emplace<circle_collider>(entity, bullet_collider);
 
-    float scale = bullet_collider.radius * 2 / 16.0f;
+    const float scale = bullet_collider.radius * 2 / 16.0f;
 
-    entt::entity texture_entity = entt::null;
-    if (bullet_team == team::PLAYER)
-    {
-        texture_entity = registry.view<Texture2D, entt::tag<blue_texture_tag>>().front();
-    } else
-    {
-        texture_entity = registry.view<Texture2D, entt::tag<red_texture_tag>>().front();
-    }
-
-    Texture2D tilesheet = registry.get<Texture2D>(texture_entity);
-
-    sprite_sequence explosion_sequence = {
+    sprite_sequence bullet_sequence = {
         .frames              = frames,
         .loop                = true,
         .update              = true,
         .current_frame_index = 0,
         .frame_time          = 0.2f,
     };
-    registry.emplace<sprite_render>(entity,
-                                    sprite_render{
-                                        tilesheet,
-                                        frames->at(0).source,
-                                        scale,
-                                        WHITE});
-    registry.emplace<sprite_sequence>(entity, explosion_sequence);
 
-    registry.emplace<team>(entity, bullet_team);
+    prefab_pools& pools = prefab_pools::of(registry);
 
-    return entity;
+    auto& entities = spawn_scratch<entt::entity>(count);
+
+    const std::size_t reused = pools.acquire(registry, pooled_prefab::BULLET, entities.data(), count);
+    registry.create(entities.begin() + reused, entities.end());
+    pools.created(pooled_prefab::BULLET, count - reused);
+
+    auto& transforms = spawn_scratch<transform>(count);
+    auto& bodies     = spawn_scratch<physics>(count);
+    auto& filters    = spawn_scratch<collision_filter>(count);
+    auto& sprites    = spawn_scratch<sprite_render>(count);
+    auto& teams      = spawn_scratch<team>(count);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const bullet_spawn& spawn = spawns[i];
+
+        const float angle = atan2(spawn.velocity.y, spawn.velocity.x) * RAD2DEG;
+
+        transforms[i] = transform{spawn.position, angle};
+        bodies[i]     = physics{spawn.velocity, 0, 0.0f, Vector2{0, 0}, Vector2{0, 0}};
+        filters[i]    = make_collision_filter(spawn.bullet_team, collider_role::BULLET);
+        sprites[i]    = sprite_render{spawn.bullet_team == team::PLAYER ? blue_tilesheet : red_tilesheet, frames->at(0).source, scale, WHITE};
+        teams[i]      = spawn.bullet_team;
+
+        if (created != nullptr)
+            created[i] = entities[i];
+    }
+
+    for (std::size_t i = 0; i < reused; i++)
+    {
+        assign_components(registry, entities[i], transforms[i], bodies[i], lifetime{2.5f}, bullet_collider, filters[i], sprites[i], bullet_sequence, teams[i]);
+    }
+
+    const auto first = entities.begin() + reused;
+    const auto last  = entities.end();
+
+    registry.insert<transform>(first, last, transforms.begin() + reused);
+    registry.insert<physics>(first, last, bodies.begin() + reused);
+    registry.insert<lifetime>(first, last, lifetime{2.5f});
+    registry.insert<circle_collider>(first, last, bullet_collider);
+    registry.insert<collision_filter>(first, last, filters.begin() + reused);
+    registry.insert<sprite_render>(first, last, sprites.begin() + reused);
+    registry.insert<sprite_sequence>(first, last, bullet_sequence);
+    registry.insert<team>(first, last, teams.begin() + reused);
+    registry.insert<pooled>(first, last, pooled{pooled_prefab::BULLET, true});
 }
 
-entt::entity spawn_explosion(entt::registry& registry, Vector2 position, float scale)
+entt::entity spawn_bullet(entt::registry& registry, Vector2 position, Vector2 velocity, const team& bullet_team)
 {
-    static const std::uint32_t texture_tag = static_cast<std::uint32_t>(GAME_TEXTURES::PLANETEXTURE);
+    scoped_trace_zone zone("spawn_bullet");
+
+    const bullet_spawn spawn = {position, velocity, bullet_team};
 
+    entt::entity entity = entt::null;
+    spawn_bullets(registry, &spawn, 1, &entity);
+
+    return entity;
+}
+
+void spawn_explosions(entt::registry& registry, const explosion_spawn* spawns, std::size_t count, entt::entity* created)
+{
     static std::shared_ptr<std::vector<sprite_frame>> frames =
         std::make_shared<std::vector<sprite_frame>>(std::initializer_list<sprite_frame>{{Rectangle{68, 0, 16, 16}},
                                                                                         {Rectangle{85, 0, 16, 16}},
@@ -240,10 +264,10 @@ entt::entity spawn_explosion(entt::registry& registry, Vector2 position, float s
                                                                                         {Rectangle{119, 0, 16, 16}},
                                                                                         {Rectangle{136, 0, 16, 16}}});
 
-    auto texture_entity = registry.view<Texture2D, entt::tag<texture_tag>>().front();
-    Texture2D tilesheet = registry.get<Texture2D>(texture_entity);
+    if (count == 0)
+        return;
 
-    entt::entity entity = registry.create();
+    Texture2D tilesheet = game_texture(GAME_TEXTURES::PLANETEXTURE);
 
     sprite_sequence explosion_sequence = {
         .frames              = frames,
@@ -253,10 +277,47 @@ entt::entity spawn_explosion(entt::registry& registry, Vector2 position, float s
         .frame_time          = 0.2f,
     };
 
-    registry.emplace<sprite_render>(entity, sprite_render{tilesheet, frames->at(0).source, scale, WHITE});
-    registry.emplace<sprite_sequence>(entity, explosion_sequence);
-    registry.emplace<transform>(entity, transform{position, 0});
-    registry.emplace<lifetime>(entity, lifetime{0.2f * 5, 0});
+    prefab_pools& pools = prefab_pools::of(registry);
+
+    auto& entities = spawn_scratch<entt::entity>(count);
+
+    const std::size_t reused = pools.acquire(registry, pooled_prefab::EXPLOSION, entities.data(), count);
+    registry.create(entities.begin() + reused, entities.end());
+    pools.created(pooled_prefab::EXPLOSION, count - reused);
+
+    auto& transforms = spawn_scratch<transform>(count);
+    auto& sprites    = spawn_scratch<sprite_render>(count);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        transforms[i] = transform{spawns[i].position, 0};
+        sprites[i]    = sprite_render{tilesheet, frames->at(0).source, spawns[i].scale, WHITE};
+
+        if (created != nullptr)
+            created[i] = entities[i];
+    }
+
+    for (std::size_t i = 0; i < reused; i++)
+    {
+        assign_components(registry, entities[i], sprites[i], explosion_sequence, transforms[i], lifetime{0.2f * 5});
+    }
+
+    const auto first = entities.begin() + reused;
+    const auto last  = entities.end();
+
+    registry.insert<sprite_render>(first, last, sprites.begin() + reused);
+    registry.insert<sprite_sequence>(first, last, explosion_sequence);
+    registry.insert<transform>(first, last, transforms.begin() + reused);
+    registry.insert<lifetime>(first, last, lifetime{0.2f * 5});
+    registry.insert<pooled>(first, last, pooled{pooled_prefab::EXPLOSION, true});
+}
+
+entt::entity spawn_explosion(entt::registry& registry, Vector2 position, float scale)
+{
+    const explosion_spawn spawn = {position, scale};
+
+    entt::entity entity = entt::null;
+    spawn_explosions(registry, &spawn, 1, &entity);
 
     return entity;
 }
@@ -305,22 +366,20 @@ void spawn_game_ui(entt::registry& registry)
             return "";
         }
 
-        auto player_data = registry.get<Player>(player_entity);
+        const auto& player_data = registry.get<Player>(player_entity);
 
-        std::ostringstream ss;
+        // PERF: Runs every frame, a fixed buffer keeps it off the heap
+        static char lives[16];
 
-        for (int i = 0; i < player_data.lives; i++)
-        {
-            ss << "X";
-        }
+        const int count = std::min<int>(player_data.lives, sizeof(lives) - 1);
 
-        ss << std::setw(3)
-           << std::setfill(' ');
+        std::fill_n(lives, count, 'X');
+        lives[count] = '\0';
 
-        return TextFormat("%s", ss.str().c_str());
+        return lives;
     };
 
-    float screenWidth = GetScreenWidth();
+    float screenWidth = get_platform().screen_width();
 
     Vector2 position = Vector2{screenWidth / 2.0f,
                                10};
@@ -352,8 +411,8 @@ void spawn_game_over(entt::registry& registry)
         registry.emplace<text_render>(text_entity, text_component);
     };
 
-    float screenWidth  = GetScreenWidth();
-    float screenHeight = GetScreenHeight();
+    float screenWidth  = get_platform().screen_width();
+    float screenHeight = get_platform().screen_height();
 
     const char* title_text = "GAME OVER";
 
@@ -0,0 +1,116 @@
+#include <utils/allocation_tracker.hpp>
+
+#include <cstdlib>
+#include <new>
+
+static thread_local std::size_t current_zone = allocation_tracker::untracked_zone;
+
+allocation_tracker& allocation_tracker::instance()
+{
+    // NOTE: Constant initialized, so it is ready before the first static constructor allocates
+    static allocation_tracker tracker;
+    return tracker;
+}
+
+std::size_t allocation_tracker::zone(std::string_view name)
+{
+    for (std::size_t zone = 0; zone < _zone_count; zone++)
+    {
+        if (_names[zone] == name)
+            return zone;
+    }
+
+    if (_zone_count == max_zones)
+        return untracked_zone;
+
+    _names[_zone_count] = name;
+    return _zone_count++;
+}
+
+std::size_t allocation_tracker::enter_zone(std::size_t zone)
+{
+    const std::size_t previous = current_zone;
+    current_zone               = zone;
+    return previous;
+}
+
+void allocation_tracker::record_allocation(std::size_t bytes)
+{
+    zone_counters& counters = _counters[current_zone];
+
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void allocation_tracker::record_free()
+{
+    _counters[current_zone].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+allocation_counts allocation_tracker::zone_counts(std::size_t zone) const
+{
+    const zone_counters& counters = _counters[zone];
+
+    return allocation_counts{counters.allocations.load(std::memory_order_relaxed), counters.bytes.load(std::memory_order_relaxed),
+                             counters.frees.load(std::memory_order_relaxed)};
+}
+
+allocation_counts allocation_tracker::totals() const
+{
+    allocation_counts total;
+
+    for (std::size_t zone = 0; zone < max_zones; zone++)
+    {
+        const allocation_counts counts = zone_counts(zone);
+
+        total.allocations += counts.allocations;
+        total.bytes += counts.bytes;
+        total.frees += counts.frees;
+    }
+
+    return total;
+}
+
+#if ASTEROIDS_TRACK_ALLOCATIONS
+
+// INFO: The other forms (arrays, nothrow, sized delete) fall back on these two
+void* operator new(std::size_t size)
+{
+    allocation_tracker::instance().record_allocation(size);
+
+    if (void* pointer = std::malloc(size == 0 ? 1 : size); pointer != nullptr)
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+        return;
+
+    allocation_tracker::instance().record_free();
+    std::free(pointer);
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include <utils/asset_archive.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <platform/platform.hpp>
+#include <utils/texture_cache.hpp>
+
+bool asset_source_size(const char* path, std::uint64_t& size)
+{
+    std::error_code error;
+
+    const std::uintmax_t file_size = std::filesystem::file_size(path, error);
+
+    if (error)
+        return false;
+
+    size = static_cast<std::uint64_t>(file_size);
+
+    return true;
+}
+
+bool asset_archive::open(const char* path)
+{
+    close();
+
+    if (!_file.open(path))
+        return false;
+
+    const unsigned char* data = _file.data();
+    const std::size_t size    = _file.size();
+
+    asset_archive_header header;
+
+    if (size < sizeof(header))
+    {
+        close();
+        return false;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+
+    // NOTE: An archive packed by another version of the tool is ignored, the PNGs still load
+    if (std::memcmp(header.magic, asset_archive_magic, sizeof(header.magic)) != 0 || header.version != asset_archive_version ||
+        size < sizeof(header) + static_cast<std::size_t>(header.entry_count) * sizeof(asset_archive_entry))
+    {
+        close();
+        return false;
+    }
+
+    // INFO: The table follows the header, which keeps it aligned for reading in place
+    const asset_archive_entry* entries = reinterpret_cast<const asset_archive_entry*>(data + sizeof(header));
+
+    for (std::uint32_t i = 0; i < header.entry_count; i++)
+    {
+        const asset_archive_entry& entry = entries[i];
+
+        const std::uint64_t pixel_bytes = static_cast<std::uint64_t>(entry.width) * entry.height * 4;
+        const bool compressed           = (entry.flags & ASSET_COMPRESSED) != 0;
+
+        if (entry.offset > size || entry.size > size - entry.offset || entry.unpacked_size != pixel_bytes ||
+            (!compressed && entry.size != pixel_bytes))
+        {
+            close();
+            return false;
+        }
+
+        std::uint64_t source_size = 0;
+
+        // NOTE: Only a stat, reading the PNGs here would cost what the archive saves. Edits that
+        // keep the size are caught by asset_packer --check at build time. A missing PNG leaves
+        // the archive as the only copy, it is used as is then.
+        if (asset_source_size(game_texture_path(static_cast<GAME_TEXTURES>(entry.texture_id)), source_size) &&
+            source_size != entry.source_size)
+            continue;
+
+        _entries.push_back(&entry);
+    }
+
+    return true;
+}
+
+void asset_archive::close()
+{
+    _file.close();
+    _entries.clear();
+}
+
+const asset_archive_entry* asset_archive::find(GAME_TEXTURES texture_id) const
+{
+    // NOTE: A handful of entries, a linear scan beats anything fancier
+    for (const asset_archive_entry* entry : _entries)
+    {
+        if (entry->texture_id == static_cast<std::uint32_t>(texture_id))
+            return entry;
+    }
+
+    return nullptr;
+}
+
+Texture2D asset_archive::upload(GAME_TEXTURES texture_id) const
+{
+    const asset_archive_entry* entry = find(texture_id);
+
+    if (entry == nullptr)
+        return Texture2D{};
+
+    const unsigned char* stored = pixels(*entry);
+    const int width             = static_cast<int>(entry->width);
+    const int height            = static_cast<int>(entry->height);
+
+    if ((entry->flags & ASSET_COMPRESSED) == 0)
+        return get_platform().upload_pixels(stored, width, height);
+
+    int unpacked_size       = 0;
+    unsigned char* unpacked = DecompressData(stored, static_cast<int>(entry->size), &unpacked_size);
+
+    Texture2D texture = {};
+
+    if (unpacked != nullptr && static_cast<std::uint64_t>(unpacked_size) == entry->unpacked_size)
+        texture = get_platform().upload_pixels(unpacked, width, height);
+
+    MemFree(unpacked);
+
+    return texture;
+}
+
+asset_archive& get_asset_archive()
+{
+    static asset_archive archive;
+    static bool attempted = false;
+
+    // NOTE: Tried once, a missing archive is not looked for again every texture load
+    if (!attempted)
+    {
+        attempted = true;
+        archive.open(game_archive_path);
+    }
+
+    return archive;
+}
@@ -0,0 +1,124 @@
+#include <utils/asset_loader.hpp>
+
+#include <platform/platform.hpp>
+#include <utils/asset_archive.hpp>
+#include <utils/texture_cache.hpp>
+#include <utils/trace_writer.hpp>
+#include <utility>
+
+asset_loader::~asset_loader()
+{
+    if (_worker.joinable())
+        _worker.join();
+
+    // NOTE: Decoded but never uploaded, only the CPU copy needs freeing
+    for (const decoded_image& decoded : _decoded)
+    {
+        get_platform().unload_image(decoded.image);
+    }
+}
+
+void asset_loader::start()
+{
+    if (!ready())
+        return;
+
+    if (_worker.joinable())
+        _worker.join();
+
+    _requested.clear();
+    _archived.clear();
+    _uploaded = 0;
+
+    const asset_archive& archive = get_asset_archive();
+    std::vector<GAME_TEXTURES> decoded_ids;
+
+    for (const GAME_TEXTURES texture_id : game_texture_ids)
+    {
+        if (has_game_texture(texture_id))
+            continue;
+
+        _requested.push_back(texture_id);
+
+        // INFO: Packed textures are already decoded, only the PNGs need the worker
+        if (archive.contains(texture_id))
+            _archived.push_back(texture_id);
+        else
+            decoded_ids.push_back(texture_id);
+    }
+
+    if (decoded_ids.empty())
+        return;
+
+    _worker = std::thread(&asset_loader::decode, this, std::move(decoded_ids));
+}
+
+void asset_loader::decode(std::vector<GAME_TEXTURES> texture_ids)
+{
+    // NOTE: No trace zones here, the trace writer only takes events from the thread running
+    // the scenes
+    for (const GAME_TEXTURES texture_id : texture_ids)
+    {
+        const Image image = get_platform().decode_image(game_texture_path(texture_id));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _decoded.push_back(decoded_image{texture_id, image});
+    }
+}
+
+std::size_t asset_loader::upload_decoded(std::size_t max_uploads)
+{
+    std::size_t uploads = 0;
+
+    while (uploads < max_uploads && !_archived.empty())
+    {
+        scoped_trace_zone zone("upload_texture");
+
+        load_game_texture(_archived.back());
+        _archived.pop_back();
+
+        _uploaded++;
+        uploads++;
+    }
+
+    while (uploads < max_uploads)
+    {
+        decoded_image decoded;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (_decoded.empty())
+                break;
+
+            decoded = _decoded.back();
+            _decoded.pop_back();
+        }
+
+        scoped_trace_zone zone("upload_texture");
+
+        // NOTE: Loaded synchronously in the meantime, add_game_texture unloads the duplicate
+        add_game_texture(decoded.texture_id, get_platform().upload_texture(decoded.image));
+
+        _uploaded++;
+        uploads++;
+    }
+
+    return uploads;
+}
+
+float asset_loader::progress() const
+{
+    if (_requested.empty())
+        return 1.0f;
+
+    return static_cast<float>(_uploaded) / static_cast<float>(_requested.size());
+}
+
+void asset_loader::finish()
+{
+    if (_worker.joinable())
+        _worker.join();
+
+    upload_decoded(_requested.size());
+}
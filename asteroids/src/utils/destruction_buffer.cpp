@@ -0,0 +1,43 @@
+#include <utils/destruction_buffer.hpp>
+
+#include <utils/prefab_pool.hpp>
+
+destruction_buffer& destruction_buffer::of(entt::registry& registry)
+{
+    return registry.ctx().emplace<destruction_buffer>();
+}
+
+void destruction_buffer::queue(entt::registry& registry, entt::entity entity)
+{
+    if (!registry.valid(entity) || queued(entity))
+        return;
+
+    if (registry.all_of<pooled>(entity))
+    {
+        _parked.push(entity);
+        return;
+    }
+
+    _destroyed.push(entity);
+}
+
+void destruction_buffer::flush(entt::registry& registry)
+{
+    if (!_parked.empty())
+    {
+        prefab_pools& pools = prefab_pools::of(registry);
+
+        for (const entt::entity entity : _parked)
+        {
+            pools.park(registry, entity);
+        }
+
+        _parked.clear();
+    }
+
+    if (!_destroyed.empty())
+    {
+        registry.destroy(_destroyed.begin(), _destroyed.end());
+        _destroyed.clear();
+    }
+}
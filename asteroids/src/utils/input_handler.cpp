@@ -1,6 +1,7 @@
 #include <raylib.h>
 
 #include <math.hpp>
+#include <platform/platform.hpp>
 #include <utils/input_handler.hpp>
 
 #include "components/player.hpp"
@@ -22,19 +23,19 @@ input_handler::~input_handler()
 
 void input_handler::handle_input()
 {
-    if (IsKeyDown(KEY_SPACE) && acceleration_button_pressed != nullptr)
+    if (get_platform().is_key_down(KEY_SPACE) && acceleration_button_pressed != nullptr)
     {
         acceleration_button_pressed->execute(Vector2Zero());
     }
 
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON) && acceleration_button_pressed != nullptr)
+    if (get_platform().is_mouse_button_down(MOUSE_LEFT_BUTTON) && acceleration_button_pressed != nullptr)
     {
         shoot_button_pressed->execute(Vector2Zero());
     }
 
     if (mouse_moved != nullptr)
     {
-        auto mouse_position = GetMousePosition();
+        auto mouse_position = get_platform().mouse_position();
         mouse_moved->execute(mouse_position);
 
         // DrawCircleV(mouse_position, 5, RED);
@@ -0,0 +1,110 @@
+#include <utils/mapped_file.hpp>
+
+// NOTE: Kept away from raylib.h, windows.h declares names that clash with it
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+mapped_file::~mapped_file()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool mapped_file::open(const char* path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (mapping == nullptr)
+        return false;
+
+    // NOTE: The view keeps the mapping alive, the handles are not needed past this point
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (view == nullptr)
+        return false;
+
+    _data = static_cast<const unsigned char*>(view);
+    _size = static_cast<std::size_t>(file_size.QuadPart);
+
+    return true;
+}
+
+void mapped_file::close()
+{
+    if (_data != nullptr)
+        UnmapViewOfFile(_data);
+
+    _data = nullptr;
+    _size = 0;
+}
+
+#else
+
+bool mapped_file::open(const char* path)
+{
+    close();
+
+    const int descriptor = ::open(path, O_RDONLY);
+
+    if (descriptor < 0)
+        return false;
+
+    struct stat file_stat;
+
+    if (fstat(descriptor, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        ::close(descriptor);
+        return false;
+    }
+
+    const std::size_t file_size = static_cast<std::size_t>(file_stat.st_size);
+
+    // NOTE: The mapping keeps the file alive, the descriptor is not needed past this point
+    void* view = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    _data = static_cast<const unsigned char*>(view);
+    _size = file_size;
+
+    return true;
+}
+
+void mapped_file::close()
+{
+    if (_data != nullptr)
+        munmap(const_cast<unsigned char*>(_data), _size);
+
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <utils/prefab_pool.hpp>
+
+#include <algorithm>
+#include <components/base.hpp>
+#include <components/physics.hpp>
+#include <components/render.hpp>
+#include <utils/timer_queue.hpp>
+
+prefab_pools& prefab_pools::of(entt::registry& registry)
+{
+    return registry.ctx().emplace<prefab_pools>();
+}
+
+std::size_t prefab_pools::acquire(entt::registry& registry, pooled_prefab prefab, entt::entity* entities, std::size_t count)
+{
+    auto& parked = _parked[static_cast<std::size_t>(prefab)];
+
+    std::size_t taken = 0;
+
+    while (taken < count && !parked.empty())
+    {
+        const entt::entity entity = parked.back();
+        parked.pop_back();
+
+        // NOTE: Handles left over from a cleared registry are dropped
+        if (!registry.valid(entity))
+            continue;
+
+        registry.get<pooled>(entity).active = true;
+        entities[taken++]                   = entity;
+    }
+
+    auto& stats  = _stats[static_cast<std::size_t>(prefab)];
+    stats.parked = static_cast<std::uint32_t>(parked.size());
+    stats.reused += taken;
+
+    activated(prefab, taken);
+
+    return taken;
+}
+
+void prefab_pools::created(pooled_prefab prefab, std::size_t count)
+{
+    _stats[static_cast<std::size_t>(prefab)].created += count;
+
+    activated(prefab, count);
+}
+
+void prefab_pools::activated(pooled_prefab prefab, std::size_t count)
+{
+    auto& stats = _stats[static_cast<std::size_t>(prefab)];
+
+    stats.active += static_cast<std::uint32_t>(count);
+    stats.high_water = std::max(stats.high_water, stats.active);
+}
+
+void prefab_pools::park(entt::registry& registry, entt::entity entity)
+{
+    auto& pooled_data = registry.get<pooled>(entity);
+
+    if (!pooled_data.active)
+        return;
+
+    pooled_data.active = false;
+
+    if (auto physics_data = registry.try_get<physics>(entity); physics_data != nullptr)
+    {
+        *physics_data = physics{Vector2{0, 0}, 0, 0.0f, Vector2{0, 0}, Vector2{0, 0}};
+    }
+
+    if (auto filter_data = registry.try_get<collision_filter>(entity); filter_data != nullptr)
+    {
+        *filter_data = collision_filter{0, 0};
+    }
+
+    if (auto render_data = registry.try_get<sprite_render>(entity); render_data != nullptr)
+    {
+        render_data->tint.a = 0;
+    }
+
+    if (auto sequence_data = registry.try_get<sprite_sequence>(entity); sequence_data != nullptr)
+    {
+        sequence_data->update = false;
+    }
+
+    if (auto lifetime_data = registry.try_get<lifetime>(entity); lifetime_data != nullptr)
+    {
+        // NOTE: Written directly so no timer is scheduled, the pending one no longer matches
+        lifetime_data->expiry_tick = timer_queue::never;
+    }
+
+    const std::size_t index = static_cast<std::size_t>(pooled_data.prefab);
+
+    _parked[index].push_back(entity);
+
+    _stats[index].active--;
+    _stats[index].parked = static_cast<std::uint32_t>(_parked[index].size());
+}
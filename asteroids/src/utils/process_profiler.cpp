@@ -0,0 +1,127 @@
+#include <utils/process_profiler.hpp>
+
+#include <algorithm>
+#include <cinttypes>
+
+process_profiler& process_profiler::instance()
+{
+    static process_profiler profiler;
+    return profiler;
+}
+
+process_profiler::process_profiler() :
+    _epoch(std::chrono::steady_clock::now()), _slots(new frame_slot[frame_capacity])
+{
+    _current          = profiled_frame{};
+    _current.start_ns = now();
+}
+
+std::int64_t process_profiler::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+void process_profiler::begin_sample(std::string_view name)
+{
+    if (_current.sample_count == max_samples_per_frame)
+    {
+        _current.dropped_samples++;
+        _open_sample = max_samples_per_frame;
+        return;
+    }
+
+    _open_sample = _current.sample_count++;
+    _current.samples[_open_sample] = process_sample{name, now(), 0, 0};
+}
+
+void process_profiler::end_sample()
+{
+    if (_open_sample == max_samples_per_frame)
+        return;
+
+    process_sample& sample = _current.samples[_open_sample];
+    sample.duration_ns     = now() - sample.start_ns;
+
+    _open_sample = max_samples_per_frame;
+}
+
+void process_profiler::add_entities(std::uint32_t count)
+{
+    if (_open_sample == max_samples_per_frame)
+        return;
+
+    _current.samples[_open_sample].entities += count;
+}
+
+void process_profiler::next_frame()
+{
+    const std::int64_t end = now();
+
+    const std::uint64_t index = _published.load(std::memory_order_relaxed);
+    _current.index            = index;
+    _current.duration_ns      = end - _current.start_ns;
+
+    frame_slot& slot = _slots[index % frame_capacity];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.frame = _current;
+
+    slot.sequence.store(2 * (index + 1), std::memory_order_release);
+    _published.store(index + 1, std::memory_order_release);
+
+    // INFO: Only the header needs resetting, samples past sample_count are never read
+    _current.start_ns        = end;
+    _current.sample_count    = 0;
+    _current.dropped_samples = 0;
+    _open_sample             = max_samples_per_frame;
+}
+
+bool process_profiler::read_frame(std::size_t frames_ago, profiled_frame& frame) const
+{
+    const std::uint64_t published = _published.load(std::memory_order_acquire);
+
+    if (frames_ago >= published || frames_ago >= frame_capacity)
+        return false;
+
+    const std::uint64_t index = published - 1 - frames_ago;
+    const frame_slot& slot    = _slots[index % frame_capacity];
+
+    if (slot.sequence.load(std::memory_order_acquire) != 2 * (index + 1))
+        return false;
+
+    frame = slot.frame;
+
+    // NOTE: The writer may have lapped the ring while copying, then the copy is torn
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == 2 * (index + 1);
+}
+
+void process_profiler::dump(std::FILE* file) const
+{
+    std::fprintf(file, "frame,frame_ms,process,start_ms,duration_ms,entities\n");
+
+    const std::uint64_t published = published_frames();
+    const std::size_t available   = static_cast<std::size_t>(std::min<std::uint64_t>(published, frame_capacity));
+
+    // NOTE: Big enough that it should not live on the stack
+    std::unique_ptr<profiled_frame> frame = std::make_unique<profiled_frame>();
+
+    for (std::size_t frames_ago = available; frames_ago-- > 0;)
+    {
+        if (!read_frame(frames_ago, *frame))
+            continue;
+
+        for (std::uint32_t i = 0; i < frame->sample_count; i++)
+        {
+            const process_sample& sample = frame->samples[i];
+
+            std::fprintf(file, "%" PRIu64 ",%.4f,%.*s,%.4f,%.4f,%" PRIu32 "\n", frame->index, frame->duration_ns / 1e6,
+                         static_cast<int>(sample.name.size()), sample.name.data(), sample.start_ns / 1e6, sample.duration_ns / 1e6, sample.entities);
+        }
+
+        if (frame->dropped_samples > 0)
+            std::fprintf(file, "%" PRIu64 ",%.4f,dropped,0,0,%" PRIu32 "\n", frame->index, frame->duration_ns / 1e6, frame->dropped_samples);
+    }
+}
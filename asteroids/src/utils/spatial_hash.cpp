@@ -0,0 +1,193 @@
+#include <utils/spatial_hash.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// NOTE: Keeps the grid bounded when something drifts far away from the playfield
+static const std::int32_t max_cells_per_axis = 256;
+
+void spatial_hash::clear()
+{
+    _proxies.clear();
+}
+
+void spatial_hash::insert(entt::entity entity, Vector2 previous_position, Vector2 position, float radius, collision_filter filter)
+{
+    collider_proxy proxy;
+    proxy.entity            = entity;
+    proxy.previous_position = previous_position;
+    proxy.position          = position;
+    proxy.radius            = radius;
+    proxy.filter            = filter;
+    proxy.swept             = previous_position.x != position.x || previous_position.y != position.y;
+    proxy.ghost_offset      = 0;
+    proxy.ghosts            = 0;
+
+    // INFO: Bounds cover the whole sweep so the grid never misses a tunneling pair
+    proxy.min = Vector2{std::min(previous_position.x, position.x) - radius, std::min(previous_position.y, position.y) - radius};
+    proxy.max = Vector2{std::max(previous_position.x, position.x) + radius, std::max(previous_position.y, position.y) + radius};
+
+    _proxies.push_back(proxy);
+}
+
+void spatial_hash::wrap(const playfield& field)
+{
+    // INFO: Any proxy reaching across a seam has to be within one proxy extent of it
+    float margin = 0.0f;
+
+    for (const auto& proxy : _proxies)
+    {
+        margin = std::max({margin, proxy.max.x - proxy.min.x, proxy.max.y - proxy.min.y});
+    }
+
+    const Vector2 field_max      = Vector2{field.min.x + field.size.x, field.min.y + field.size.y};
+    const std::size_t real_count = _proxies.size();
+
+    for (std::size_t index = 0; index < real_count; index++)
+    {
+        const collider_proxy& proxy = _proxies[index];
+
+        // INFO: Proxies near the min edge are mirrored past the max edge and the other way around
+        const int x = proxy.min.x - field.min.x <= margin ? 1 : (field_max.x - proxy.max.x <= margin ? -1 : 0);
+        const int y = proxy.min.y - field.min.y <= margin ? 1 : (field_max.y - proxy.max.y <= margin ? -1 : 0);
+
+        if (x == 0 && y == 0)
+            continue;
+
+        for (std::uint8_t offset = 0; offset < 8; offset++)
+        {
+            const int dx = wrap_offsets[offset][0];
+            const int dy = wrap_offsets[offset][1];
+
+            if ((dx != 0 && dx != x) || (dy != 0 && dy != y))
+                continue;
+
+            const Vector2 shift = Vector2{dx * field.size.x, dy * field.size.y};
+
+            collider_proxy ghost = _proxies[index];
+            ghost.previous_position = Vector2{ghost.previous_position.x + shift.x, ghost.previous_position.y + shift.y};
+            ghost.position          = Vector2{ghost.position.x + shift.x, ghost.position.y + shift.y};
+            ghost.min               = Vector2{ghost.min.x + shift.x, ghost.min.y + shift.y};
+            ghost.max               = Vector2{ghost.max.x + shift.x, ghost.max.y + shift.y};
+            ghost.ghost_offset      = offset + 1;
+            ghost.ghosts            = 0;
+
+            _proxies[index].ghosts |= 1u << offset;
+            _proxies.push_back(ghost);
+        }
+    }
+}
+
+std::int32_t spatial_hash::cell_x(float x) const
+{
+    auto cell = static_cast<std::int32_t>(std::floor((x - _origin.x) * _inverse_cell_size));
+    return std::clamp(cell, 0, _columns - 1);
+}
+
+std::int32_t spatial_hash::cell_y(float y) const
+{
+    auto cell = static_cast<std::int32_t>(std::floor((y - _origin.y) * _inverse_cell_size));
+    return std::clamp(cell, 0, _rows - 1);
+}
+
+void spatial_hash::build()
+{
+    _cell_entries.clear();
+
+    if (_proxies.empty())
+    {
+        _columns    = 0;
+        _rows       = 0;
+        _cell_count = 0;
+        _cell_start.assign(1, 0);
+        return;
+    }
+
+    Vector2 min = _proxies.front().min;
+    Vector2 max = _proxies.front().max;
+
+    for (const auto& proxy : _proxies)
+    {
+        min.x = std::min(min.x, proxy.min.x);
+        min.y = std::min(min.y, proxy.min.y);
+        max.x = std::max(max.x, proxy.max.x);
+        max.y = std::max(max.y, proxy.max.y);
+    }
+
+    float cell_size = _cell_size;
+
+    const float extent = std::max(max.x - min.x, max.y - min.y);
+    if (extent / cell_size > max_cells_per_axis)
+    {
+        cell_size = extent / max_cells_per_axis;
+    }
+
+    _origin            = min;
+    _inverse_cell_size = 1.0f / cell_size;
+
+    _columns    = std::clamp(static_cast<std::int32_t>((max.x - min.x) * _inverse_cell_size) + 1, 1, max_cells_per_axis);
+    _rows       = std::clamp(static_cast<std::int32_t>((max.y - min.y) * _inverse_cell_size) + 1, 1, max_cells_per_axis);
+    _cell_count = _columns * _rows;
+
+    // INFO: Counting sort, first pass counts the entries per cell, second pass scatters them
+    _cell_start.assign(_cell_count + 1, 0);
+
+    for (const auto& proxy : _proxies)
+    {
+        const std::int32_t x0 = cell_x(proxy.min.x), x1 = cell_x(proxy.max.x);
+        const std::int32_t y0 = cell_y(proxy.min.y), y1 = cell_y(proxy.max.y);
+
+        for (std::int32_t y = y0; y <= y1; y++)
+        {
+            for (std::int32_t x = x0; x <= x1; x++)
+            {
+                _cell_start[y * _columns + x + 1]++;
+            }
+        }
+    }
+
+    for (std::uint32_t cell = 0; cell < _cell_count; cell++)
+    {
+        _cell_start[cell + 1] += _cell_start[cell];
+    }
+
+    _cell_entries.resize(_cell_start[_cell_count]);
+
+    _cell_cursor.assign(_cell_start.begin(), _cell_start.end() - 1);
+
+    for (std::uint32_t index = 0; index < _proxies.size(); index++)
+    {
+        const auto& proxy = _proxies[index];
+
+        const std::int32_t x0 = cell_x(proxy.min.x), x1 = cell_x(proxy.max.x);
+        const std::int32_t y0 = cell_y(proxy.min.y), y1 = cell_y(proxy.max.y);
+
+        for (std::int32_t y = y0; y <= y1; y++)
+        {
+            for (std::int32_t x = x0; x <= x1; x++)
+            {
+                _cell_entries[_cell_cursor[y * _columns + x]++] = index;
+            }
+        }
+    }
+}
+
+void spatial_hash::partition(std::uint32_t count, std::vector<std::uint32_t>& bounds) const
+{
+    bounds.clear();
+    bounds.push_back(0);
+
+    const std::uint32_t total_entries = _cell_start.back();
+
+    for (std::uint32_t i = 1; i < count; i++)
+    {
+        const std::uint32_t target = static_cast<std::uint32_t>(static_cast<std::uint64_t>(total_entries) * i / count);
+
+        auto it            = std::lower_bound(_cell_start.begin(), _cell_start.begin() + _cell_count, target);
+        std::uint32_t cell = static_cast<std::uint32_t>(it - _cell_start.begin());
+
+        bounds.push_back(std::max(cell, bounds.back()));
+    }
+
+    bounds.push_back(_cell_count);
+}
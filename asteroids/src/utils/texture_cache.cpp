@@ -0,0 +1,86 @@
+#include <utils/texture_cache.hpp>
+
+#include <platform/platform.hpp>
+#include <utils/asset_archive.hpp>
+
+texture_loader::result_type texture_loader::operator()(const char* path) const
+{
+    return (*this)(get_platform().load_texture(path));
+}
+
+texture_loader::result_type texture_loader::operator()(Texture2D texture) const
+{
+    return result_type(new Texture2D(texture), [](Texture2D* texture) {
+        get_platform().unload_texture(*texture);
+        delete texture;
+    });
+}
+
+const char* game_texture_path(GAME_TEXTURES texture_id)
+{
+    switch (texture_id)
+    {
+        case GAME_TEXTURES::MAINTEXTURE:
+            return "resources/simpleSpace_tilesheet.png";
+        case GAME_TEXTURES::PLANETEXTURE:
+            return "resources/simplePlanes_tilesheet.png";
+        case GAME_TEXTURES::SMOKETEXTURE:
+            return "resources/smoke_fx.png";
+        case GAME_TEXTURES::BULLETTEXTURE_BLUE:
+            return "resources/bullet_blue.png";
+        case GAME_TEXTURES::BULLETTEXTURE_RED:
+            return "resources/bullet_red.png";
+        // NOTE: Reserved, there is no explosion sheet yet
+        case GAME_TEXTURES::EXPLOSIONTEXTURE:
+            break;
+    }
+
+    return "";
+}
+
+texture_cache& get_texture_cache()
+{
+    // NOTE: Never destroyed, at exit the platform it would unload through may already be gone.
+    // unload_game_textures is the orderly way out.
+    static texture_cache* cache = new texture_cache();
+    return *cache;
+}
+
+entt::resource<Texture2D> load_game_texture(GAME_TEXTURES texture_id)
+{
+    const entt::id_type id = static_cast<entt::id_type>(texture_id);
+    texture_cache& cache   = get_texture_cache();
+
+    // INFO: A packed archive skips decoding, its pixels go from the mapping to the GPU
+    if (!cache.contains(id))
+    {
+        const asset_archive& archive = get_asset_archive();
+
+        if (archive.contains(texture_id))
+            return cache.load(id, archive.upload(texture_id)).first->second;
+    }
+
+    // NOTE: load only calls the loader for ids the cache does not hold yet
+    return cache.load(id, game_texture_path(texture_id)).first->second;
+}
+
+void add_game_texture(GAME_TEXTURES texture_id, Texture2D texture)
+{
+    if (has_game_texture(texture_id))
+    {
+        get_platform().unload_texture(texture);
+        return;
+    }
+
+    get_texture_cache().load(static_cast<entt::id_type>(texture_id), texture);
+}
+
+bool has_game_texture(GAME_TEXTURES texture_id)
+{
+    return get_texture_cache().contains(static_cast<entt::id_type>(texture_id));
+}
+
+void unload_game_textures()
+{
+    get_texture_cache().clear();
+}
@@ -0,0 +1,81 @@
+#include <utils/timer_queue.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <components/base.hpp>
+#include <utils/destruction_buffer.hpp>
+
+timer_queue& timer_queue::of(entt::registry& registry)
+{
+    return registry.ctx().emplace<timer_queue>();
+}
+
+void timer_queue::schedule(float delay, timer_callback callback)
+{
+    push(expiry_tick(delay), entt::null, callback);
+}
+
+void timer_queue::expire(entt::registry& registry, entt::entity entity)
+{
+    auto& lifetime_data = registry.get<lifetime>(entity);
+
+    if (!std::isfinite(lifetime_data.lifetime))
+    {
+        lifetime_data.expiry_tick = never;
+        return;
+    }
+
+    lifetime_data.expiry_tick = expiry_tick(lifetime_data.lifetime);
+    push(lifetime_data.expiry_tick, entity, timer_callback{});
+}
+
+std::size_t timer_queue::advance(entt::registry& registry, float tick_time)
+{
+    _tick_time = tick_time;
+
+    std::size_t fired = 0;
+
+    while (!_timers.empty() && _timers.front().expiry <= _tick)
+    {
+        std::pop_heap(_timers.begin(), _timers.end(), later{});
+        const timer due = _timers.back();
+        _timers.pop_back();
+
+        fired++;
+
+        // NOTE: Popped before the call, callbacks are free to schedule more timers
+        if (due.callback)
+        {
+            due.callback(registry);
+            continue;
+        }
+
+        // NOTE: Timers of entities that died early, or of pooled ones reused since, are stale
+        if (!registry.valid(due.entity))
+            continue;
+
+        const auto lifetime_data = registry.try_get<lifetime>(due.entity);
+        if (lifetime_data == nullptr || lifetime_data->expiry_tick != due.expiry)
+            continue;
+
+        destroy_deferred(registry, due.entity);
+    }
+
+    _tick++;
+    return fired;
+}
+
+std::uint64_t timer_queue::expiry_tick(float delay) const
+{
+    // NOTE: Rounded up to whole ticks, the epsilon keeps float error from adding a tick to delays
+    // that are an exact multiple of the tick time
+    const float ticks = std::ceil(delay / _tick_time - 1e-3f);
+
+    return _tick + static_cast<std::uint64_t>(std::max(ticks, 0.0f));
+}
+
+void timer_queue::push(std::uint64_t expiry, entt::entity entity, timer_callback callback)
+{
+    _timers.push_back(timer{expiry, _sequence++, entity, callback});
+    std::push_heap(_timers.begin(), _timers.end(), later{});
+}
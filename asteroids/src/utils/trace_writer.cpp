@@ -0,0 +1,155 @@
+#include <utils/trace_writer.hpp>
+
+#include <cstdlib>
+
+trace_writer& trace_writer::instance()
+{
+    static trace_writer writer;
+    return writer;
+}
+
+trace_writer::~trace_writer()
+{
+    stop();
+}
+
+bool trace_writer::start(const char* path)
+{
+    if (_enabled)
+        return true;
+
+    _file = std::fopen(path, "w");
+    if (_file == nullptr)
+        return false;
+
+    std::fprintf(_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(_file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"frame\"}}");
+
+    _epoch    = clock::now();
+    _stopping = false;
+
+    _current = std::make_unique<event_buffer>();
+    _current->reserve(buffer_capacity);
+
+    _thread  = std::thread(&trace_writer::writer_loop, this);
+    _enabled = true;
+
+    return true;
+}
+
+bool trace_writer::start_from_environment()
+{
+    const char* path = std::getenv("ASTEROIDS_TRACE");
+
+    if (path == nullptr || *path == '\0')
+        return _enabled;
+
+    return start(path);
+}
+
+void trace_writer::stop()
+{
+    if (!_enabled)
+        return;
+
+    _enabled = false;
+    submit();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _wake.notify_one();
+    _thread.join();
+
+    std::fprintf(_file, "\n]}\n");
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void trace_writer::write_zone(std::string_view name, clock::time_point start, clock::time_point end)
+{
+    _current->push_back(trace_event{name, start, end});
+
+    if (_current->size() == buffer_capacity)
+        submit();
+}
+
+void trace_writer::submit()
+{
+    if (_current->empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _full.push_back(std::move(_current));
+
+        if (!_free.empty())
+        {
+            _current = std::move(_free.back());
+            _free.pop_back();
+        }
+    }
+
+    _wake.notify_one();
+
+    // NOTE: Only while the writer thread lags behind, afterwards the buffers keep circulating
+    if (_current == nullptr)
+    {
+        _current = std::make_unique<event_buffer>();
+        _current->reserve(buffer_capacity);
+    }
+}
+
+void trace_writer::writer_loop()
+{
+    std::vector<std::unique_ptr<event_buffer>> pending;
+
+    while (true)
+    {
+        bool stopping = false;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this]() { return _stopping || !_full.empty(); });
+
+            pending.swap(_full);
+            stopping = _stopping;
+        }
+
+        for (auto& events : pending)
+        {
+            write_events(*events);
+            events->clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (auto& events : pending)
+            {
+                _free.push_back(std::move(events));
+            }
+        }
+
+        pending.clear();
+
+        if (stopping)
+            break;
+    }
+
+    std::fflush(_file);
+}
+
+void trace_writer::write_events(const event_buffer& events)
+{
+    for (const auto& event : events)
+    {
+        const double start    = std::chrono::duration<double, std::micro>(event.start - _epoch).count();
+        const double duration = std::chrono::duration<double, std::micro>(event.end - event.start).count();
+
+        std::fprintf(_file, ",\n{\"name\":\"%.*s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                     static_cast<int>(event.name.size()), event.name.data(), start, duration);
+    }
+}
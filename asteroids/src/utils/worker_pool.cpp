@@ -0,0 +1,116 @@
+#include <utils/worker_pool.hpp>
+
+worker_pool::worker_pool(std::size_t thread_count)
+{
+    _threads.reserve(thread_count);
+
+    for (std::size_t i = 0; i < thread_count; i++)
+    {
+        _threads.emplace_back(&worker_pool::worker_loop, this);
+    }
+}
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _wake.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void worker_pool::run(std::size_t task_count, entt::delegate<void(std::size_t)> task)
+{
+    if (task_count == 0)
+        return;
+
+    if (_threads.empty())
+    {
+        for (std::size_t index = 0; index < task_count; index++)
+        {
+            task(index);
+        }
+
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // NOTE: A worker that woke too late for the last batch may still be on its way out of
+        // work(), resetting the counters under it would hand it indices of this batch
+        _done.wait(lock, [this]() { return _active_workers == 0; });
+
+        _task       = task;
+        _task_count = task_count;
+        _next_task.store(0);
+        _finished_tasks.store(0);
+        _generation++;
+    }
+
+    _wake.notify_all();
+
+    work(task, task_count);
+
+    // NOTE: Also waits for every worker that picked up this batch to leave work(), so the next
+    // batch can safely overwrite the task without racing a late worker.
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return _finished_tasks.load() == _task_count && _active_workers == 0; });
+}
+
+void worker_pool::work(entt::delegate<void(std::size_t)> task, std::size_t task_count)
+{
+    std::size_t finished = 0;
+
+    for (std::size_t index = _next_task.fetch_add(1); index < task_count; index = _next_task.fetch_add(1))
+    {
+        task(index);
+        finished++;
+    }
+
+    if (finished == 0)
+        return;
+
+    _finished_tasks.fetch_add(finished);
+}
+
+void worker_pool::worker_loop()
+{
+    std::size_t seen_generation = 0;
+
+    while (true)
+    {
+        // INFO: Copied under the lock, the next run() overwrites the members while this worker
+        // may still be reading them
+        entt::delegate<void(std::size_t)> task;
+        std::size_t task_count = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this, &seen_generation]() { return _stopping || _generation != seen_generation; });
+
+            if (_stopping)
+                return;
+
+            seen_generation = _generation;
+            task            = _task;
+            task_count      = _task_count;
+            _active_workers++;
+        }
+
+        work(task, task_count);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _active_workers--;
+        }
+
+        _done.notify_all();
+    }
+}
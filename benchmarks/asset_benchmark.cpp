@@ -0,0 +1,137 @@
+#include <raylib.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <utils/asset_archive.hpp>
+#include <utils/texture_cache.hpp>
+
+// INFO: Gets the pixels of every game texture ready for upload, once by decoding the PNGs and
+// once out of the asset archive, and prints the time per load and the heap bytes each one
+// holds before the upload. Files come from the page cache after the first run, so the times
+// leave out the disk. Run from the asteroids directory after asset_packer.
+
+struct load_result
+{
+    double milliseconds;
+    std::uint64_t heap_bytes;
+    std::uint64_t checksum;
+};
+
+// INFO: Reads a byte of every cache line, like the upload would
+static std::uint64_t touch_pixels(const unsigned char* pixels, std::uint64_t size)
+{
+    std::uint64_t checksum = 0;
+
+    for (std::uint64_t i = 0; i < size; i += 64)
+    {
+        checksum += pixels[i];
+    }
+
+    return checksum;
+}
+
+static load_result load_from_png()
+{
+    load_result result = {0.0, 0, 0};
+    auto start         = std::chrono::steady_clock::now();
+
+    for (const GAME_TEXTURES texture_id : game_texture_ids)
+    {
+        Image image = LoadImage(game_texture_path(texture_id));
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        const std::uint64_t size = static_cast<std::uint64_t>(image.width) * image.height * 4;
+
+        result.checksum += touch_pixels(static_cast<const unsigned char*>(image.data), size);
+        result.heap_bytes += size;
+
+        UnloadImage(image);
+    }
+
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static load_result load_from_archive()
+{
+    load_result result = {0.0, 0, 0};
+    auto start         = std::chrono::steady_clock::now();
+
+    asset_archive archive;
+    archive.open(game_archive_path);
+
+    for (const GAME_TEXTURES texture_id : game_texture_ids)
+    {
+        const asset_archive_entry* entry = archive.find(texture_id);
+        const unsigned char* pixels      = archive.pixels(*entry);
+
+        if ((entry->flags & ASSET_COMPRESSED) == 0)
+        {
+            result.checksum += touch_pixels(pixels, entry->size);
+            continue;
+        }
+
+        int unpacked_size       = 0;
+        unsigned char* unpacked = DecompressData(pixels, static_cast<int>(entry->size), &unpacked_size);
+
+        result.checksum += touch_pixels(unpacked, static_cast<std::uint64_t>(unpacked_size));
+        result.heap_bytes += static_cast<std::uint64_t>(unpacked_size);
+
+        MemFree(unpacked);
+    }
+
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// INFO: Usage: asset_benchmark [runs]
+int main(int argc, char** argv)
+{
+    const std::uint32_t runs = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 20;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    asset_archive archive;
+
+    if (runs == 0 || !archive.open(game_archive_path))
+    {
+        std::printf("no usable %s, run asset_packer first\n", game_archive_path);
+        return 1;
+    }
+
+    for (const GAME_TEXTURES texture_id : game_texture_ids)
+    {
+        if (!archive.contains(texture_id))
+        {
+            std::printf("%s misses a texture, run asset_packer again\n", game_archive_path);
+            return 1;
+        }
+    }
+
+    archive.close();
+
+    double png_milliseconds    = 0.0;
+    double packed_milliseconds = 0.0;
+
+    load_result png    = {0.0, 0, 0};
+    load_result packed = {0.0, 0, 0};
+
+    for (std::uint32_t run = 0; run < runs; run++)
+    {
+        png    = load_from_png();
+        packed = load_from_archive();
+
+        png_milliseconds += png.milliseconds;
+        packed_milliseconds += packed.milliseconds;
+    }
+
+    std::printf("%u runs, %zu textures\n\n", runs, sizeof(game_texture_ids) / sizeof(game_texture_ids[0]));
+    std::printf("%-10s %12s %14s\n", "source", "ms/load", "heap bytes");
+    std::printf("%-10s %12.3f %14llu\n", "png", png_milliseconds / runs, static_cast<unsigned long long>(png.heap_bytes));
+    std::printf("%-10s %12.3f %14llu\n", "archive", packed_milliseconds / runs, static_cast<unsigned long long>(packed.heap_bytes));
+
+    // NOTE: Both loads have to see the same pixels, a stale archive shows up here
+    return png.checksum == packed.checksum ? 0 : 1;
+}
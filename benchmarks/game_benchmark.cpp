@@ -0,0 +1,454 @@
+#include <raylib.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <components/asteroid.hpp>
+#include <components/enemy.hpp>
+#include <components/player.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <entt/entt.hpp>
+#include <memory>
+#include <platform/null_platform.hpp>
+#include <platform/raylib_platform.hpp>
+#include <scenes/scene_management.hpp>
+#include <utils/allocation_tracker.hpp>
+#include <utils/frame_phases.hpp>
+#include <utils/prefab_pool.hpp>
+#include <utils/process_profiler.hpp>
+#include <utils/simulation_clock.hpp>
+#include <utils/texture_cache.hpp>
+#include <utils/trace_writer.hpp>
+#include <vector>
+
+// INFO: Runs the game scene uncapped with a configurable population and prints per frame
+// statistics for every phase. Every frame advances exactly one fixed tick, so the simulated
+// workload only depends on the options and the seed, never on how fast the machine is.
+
+struct benchmark_options
+{
+    std::uint32_t entities = 2000;
+
+    // INFO: Relative weights of the population
+    std::uint32_t asteroid_weight = 6;
+    std::uint32_t enemy_weight    = 1;
+    std::uint32_t bullet_weight   = 3;
+
+    std::uint32_t frames    = 1000;
+    std::uint32_t warmup    = 60;
+    std::uint32_t tick_rate = default_tick_rate;
+    std::uint32_t seed      = 1234;
+
+    int width  = 900;
+    int height = 600;
+
+    bool headless = true;
+    bool vsync    = false;
+
+    const char* trace_path = nullptr;
+
+    // INFO: Most heap allocations a measured frame of the game loop may make, negative is no limit
+    long allocation_budget = -1;
+};
+
+static void print_usage(const char* program)
+{
+    std::printf("usage: %s [options]\n", program);
+    std::printf("  --entities <n>       population kept alive during the run (2000)\n");
+    std::printf("  --mix <a>:<e>:<b>    asteroid, enemy and bullet weights (6:1:3)\n");
+    std::printf("  --frames <n>         measured frames (1000)\n");
+    std::printf("  --warmup <n>         frames run before measuring (60)\n");
+    std::printf("  --tick-rate <hz>     simulation ticks per second, one tick per frame (60)\n");
+    std::printf("  --seed <n>           random seed (1234)\n");
+    std::printf("  --size <w>x<h>       screen size (900x600)\n");
+    std::printf("  --headless           run without a window (default)\n");
+    std::printf("  --windowed           open a window and draw every frame\n");
+    std::printf("  --vsync, --no-vsync  wait for vertical sync when windowed (off)\n");
+    std::printf("  --trace <file>       write a Chrome trace of every frame, ASTEROIDS_TRACE works too\n");
+    std::printf("  --allocation-budget <n>\n");
+    std::printf("                       fail when a measured frame allocates more than n times,\n");
+    std::printf("                       needs a build with --track-allocations\n");
+}
+
+static bool parse_options(int argc, char** argv, benchmark_options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const char* value    = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        auto number = [&i, value]() {
+            i++;
+            return static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        };
+
+        if (std::strcmp(argument, "--headless") == 0)
+            options.headless = true;
+        else if (std::strcmp(argument, "--windowed") == 0)
+            options.headless = false;
+        else if (std::strcmp(argument, "--vsync") == 0)
+            options.vsync = true;
+        else if (std::strcmp(argument, "--no-vsync") == 0)
+            options.vsync = false;
+        else if (value == nullptr)
+            return false;
+        else if (std::strcmp(argument, "--entities") == 0)
+            options.entities = number();
+        else if (std::strcmp(argument, "--frames") == 0)
+            options.frames = number();
+        else if (std::strcmp(argument, "--warmup") == 0)
+            options.warmup = number();
+        else if (std::strcmp(argument, "--tick-rate") == 0)
+            options.tick_rate = number();
+        else if (std::strcmp(argument, "--seed") == 0)
+            options.seed = number();
+        else if (std::strcmp(argument, "--trace") == 0)
+            options.trace_path = argv[++i];
+        else if (std::strcmp(argument, "--allocation-budget") == 0)
+            options.allocation_budget = std::strtol(argv[++i], nullptr, 10);
+        else if (std::strcmp(argument, "--mix") == 0)
+        {
+            i++;
+            if (std::sscanf(value, "%u:%u:%u", &options.asteroid_weight, &options.enemy_weight, &options.bullet_weight) != 3)
+                return false;
+        } else if (std::strcmp(argument, "--size") == 0)
+        {
+            i++;
+            if (std::sscanf(value, "%dx%d", &options.width, &options.height) != 2)
+                return false;
+        } else
+            return false;
+    }
+
+    return options.tick_rate > 0 && options.asteroid_weight + options.enemy_weight + options.bullet_weight > 0;
+}
+
+// INFO: Entities the benchmark keeps alive, a slot whose entity died gets a fresh spawn
+struct population
+{
+    std::vector<entt::entity> asteroids;
+    std::vector<entt::entity> enemies;
+    std::vector<entt::entity> bullets;
+};
+
+static Vector2 random_position()
+{
+    return Vector2{static_cast<float>(get_platform().random_value(0, get_platform().screen_width())),
+                   static_cast<float>(get_platform().random_value(0, get_platform().screen_height()))};
+}
+
+static Vector2 random_velocity(int speed)
+{
+    return Vector2{static_cast<float>(get_platform().random_value(-speed, speed)), static_cast<float>(get_platform().random_value(-speed, speed))};
+}
+
+// INFO: Gathers the dead slots of one kind, spawns their replacements in one bulk call and puts
+// the new entities back into the slots
+template<typename Spawn, typename MakeSpawn, typename SpawnMany>
+static void refill(entt::registry& registry, std::vector<entt::entity>& slots, MakeSpawn make_spawn, SpawnMany spawn_many)
+{
+    static std::vector<std::size_t> dead;
+    static std::vector<Spawn> spawns;
+    static std::vector<entt::entity> created;
+
+    dead.clear();
+    spawns.clear();
+
+    for (std::size_t slot = 0; slot < slots.size(); slot++)
+    {
+        if (!is_spawned(registry, slots[slot]))
+        {
+            dead.push_back(slot);
+            spawns.push_back(make_spawn());
+        }
+    }
+
+    created.resize(spawns.size());
+    spawn_many(registry, spawns.data(), spawns.size(), created.data());
+
+    for (std::size_t i = 0; i < dead.size(); i++)
+    {
+        slots[dead[i]] = created[i];
+    }
+}
+
+static void top_up(entt::registry& registry, population& alive)
+{
+    refill<asteroid_spawn>(
+        registry, alive.asteroids,
+        []() { return asteroid_spawn{random_position(), random_velocity(150), static_cast<int8_t>(get_platform().random_value(0, 2))}; },
+        spawn_asteroids);
+
+    // INFO: Enemies have no bulk version, there are few of them next to the rest
+    for (auto& entity : alive.enemies)
+    {
+        if (!is_spawned(registry, entity))
+            entity = spawn_enemy(registry, random_position());
+    }
+
+    refill<bullet_spawn>(
+        registry, alive.bullets,
+        []() { return bullet_spawn{random_position(), random_velocity(600), get_platform().random_value(0, 1) == 0 ? team::PLAYER : team::ENEMY}; },
+        spawn_bullets);
+}
+
+struct phase_statistics
+{
+    double mean;
+    double p50;
+    double p99;
+    double max;
+};
+
+static phase_statistics summarize(std::vector<double> samples)
+{
+    if (samples.empty())
+        return phase_statistics{0, 0, 0, 0};
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+
+    auto percentile = [&samples](double fraction) {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * samples.size()));
+        return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+    };
+
+    return phase_statistics{sum / samples.size(), percentile(0.50), percentile(0.99), samples.back()};
+}
+
+// INFO: Per frame allocation statistics and the zones they came from, returns the exit code
+static int report_allocations(const benchmark_options& options, const std::vector<allocation_counts>& frame_allocations,
+                              const std::array<allocation_counts, allocation_tracker::max_zones>& zones_at_start)
+{
+    const double frame_count = static_cast<double>(frame_allocations.size());
+
+    std::uint64_t total_allocations = 0;
+    std::uint64_t total_bytes       = 0;
+    std::uint64_t max_allocations   = 0;
+    std::uint32_t frames_over       = 0;
+
+    for (const auto& counts : frame_allocations)
+    {
+        total_allocations += counts.allocations;
+        total_bytes += counts.bytes;
+        max_allocations = std::max(max_allocations, counts.allocations);
+
+        if (options.allocation_budget >= 0 && counts.allocations > static_cast<std::uint64_t>(options.allocation_budget))
+            frames_over++;
+    }
+
+    std::printf("\nallocations per frame: mean %.2f, max %llu, %.1f bytes per frame\n\n", total_allocations / frame_count,
+                static_cast<unsigned long long>(max_allocations), total_bytes / frame_count);
+
+    // INFO: Includes the population refills, which the budget leaves out
+    std::printf("%-48s %14s %14s\n", "zone", "allocs/frame", "bytes/frame");
+
+    allocation_tracker& tracker = allocation_tracker::instance();
+
+    for (std::size_t zone = 0; zone < tracker.zone_count(); zone++)
+    {
+        const allocation_counts counts  = tracker.zone_counts(zone);
+        const std::uint64_t allocations = counts.allocations - zones_at_start[zone].allocations;
+        const std::uint64_t bytes       = counts.bytes - zones_at_start[zone].bytes;
+
+        if (allocations == 0)
+            continue;
+
+        const std::string_view name = tracker.zone_name(zone);
+        std::printf("%-48.*s %14.2f %14.1f\n", static_cast<int>(name.size()), name.data(), allocations / frame_count, bytes / frame_count);
+    }
+
+    if (frames_over > 0)
+    {
+        std::printf("\nallocation budget of %ld per frame exceeded on %u of %zu frames\n", options.allocation_budget, frames_over, frame_allocations.size());
+        return 2;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    benchmark_options options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (options.allocation_budget >= 0 && !ASTEROIDS_TRACK_ALLOCATIONS)
+    {
+        std::printf("--allocation-budget needs a build with ASTEROIDS_TRACK_ALLOCATIONS=1\n");
+        return 1;
+    }
+
+    // NOTE: Declared first so it outlives the scene, the window closes after the textures are gone
+    std::unique_ptr<platform> benchmark_platform;
+
+    if (options.headless)
+    {
+        benchmark_platform = std::make_unique<null_platform>(options.width, options.height, 1.0f / options.tick_rate);
+    } else
+    {
+        SetTraceLogLevel(LOG_WARNING);
+        benchmark_platform = std::make_unique<raylib_platform>(options.width, options.height, "ASTEROIDS BENCHMARK", 0, options.vsync ? FLAG_VSYNC_HINT : 0);
+    }
+
+    if (options.trace_path != nullptr)
+        trace_writer::instance().start(options.trace_path);
+    else
+        trace_writer::instance().start_from_environment();
+
+    set_platform(benchmark_platform.get());
+    get_platform().set_random_seed(options.seed);
+
+    // INFO: Straight into the game scene, run without the scene state machine so it never leaves it
+    auto clock = std::make_shared<simulation_clock>(options.tick_rate);
+
+    scene game_scene;
+    std::shared_ptr<entt::registry> registry;
+
+    create_game_scene(game_scene, registry, clock);
+
+    game_scene.on_enter();
+
+    const std::uint32_t total_weight = options.asteroid_weight + options.enemy_weight + options.bullet_weight;
+
+    population alive;
+    alive.asteroids.assign(static_cast<std::uint64_t>(options.entities) * options.asteroid_weight / total_weight, entt::null);
+    alive.enemies.assign(static_cast<std::uint64_t>(options.entities) * options.enemy_weight / total_weight, entt::null);
+    alive.bullets.assign(options.entities - alive.asteroids.size() - alive.enemies.size(), entt::null);
+
+    // INFO: One column per frame phase, then spawning the population back up and the whole frame
+    const std::size_t spawn_column = frame_phase_count;
+    const std::size_t frame_column = frame_phase_count + 1;
+
+    std::vector<std::vector<double>> samples(frame_phase_count + 2);
+    for (auto& column : samples)
+    {
+        column.reserve(options.frames);
+    }
+
+    // INFO: Allocations of the scene update alone, refilling the population is not the game's doing
+    std::vector<allocation_counts> frame_allocations;
+    frame_allocations.reserve(options.frames);
+
+    std::array<allocation_counts, allocation_tracker::max_zones> zones_at_start = {};
+
+    const float frame_time = 1.0f / options.tick_rate;
+
+    std::uint32_t measured_frames = 0;
+    std::size_t peak_entities     = 0;
+
+    for (std::uint32_t frame = 0; frame < options.warmup + options.frames; frame++)
+    {
+        if (get_platform().should_close())
+            break;
+
+        scoped_trace_zone frame_zone("frame");
+
+        const auto frame_start = std::chrono::steady_clock::now();
+
+        {
+            scoped_trace_zone zone("top_up");
+            scoped_allocation_zone allocation_zone("top_up");
+            top_up(*registry, alive);
+        }
+
+        const auto spawn_end = std::chrono::steady_clock::now();
+
+        current_frame_phase_times() = frame_phase_times{};
+
+        if (frame == options.warmup)
+        {
+            for (std::size_t zone = 0; zone < allocation_tracker::max_zones; zone++)
+            {
+                zones_at_start[zone] = allocation_tracker::instance().zone_counts(zone);
+            }
+        }
+
+        const allocation_counts allocations_before = allocation_tracker::instance().totals();
+
+        game_scene.on_update(frame_time);
+
+        const allocation_counts allocations_after = allocation_tracker::instance().totals();
+
+        const auto frame_end = std::chrono::steady_clock::now();
+
+        profile_next_frame();
+
+        peak_entities = std::max(peak_entities, registry->view<transform>().size());
+
+        if (frame < options.warmup)
+            continue;
+
+        const frame_phase_times& times = current_frame_phase_times();
+
+        for (std::size_t phase = 0; phase < frame_phase_count; phase++)
+        {
+            samples[phase].push_back(times.seconds[phase] * 1000.0);
+        }
+
+        samples[spawn_column].push_back(std::chrono::duration<double, std::milli>(spawn_end - frame_start).count());
+        samples[frame_column].push_back(std::chrono::duration<double, std::milli>(frame_end - frame_start).count());
+
+        frame_allocations.push_back(allocation_counts{allocations_after.allocations - allocations_before.allocations,
+                                                      allocations_after.bytes - allocations_before.bytes,
+                                                      allocations_after.frees - allocations_before.frees});
+
+        measured_frames++;
+    }
+
+    // NOTE: Leaving the scene clears the registry and drops the pools with it
+    std::array<prefab_pool_stats, pooled_prefab_count> pool_stats;
+    for (std::size_t prefab = 0; prefab < pooled_prefab_count; prefab++)
+    {
+        pool_stats[prefab] = prefab_pools::of(*registry).stats(static_cast<pooled_prefab>(prefab));
+    }
+
+    game_scene.on_exit();
+    unload_game_textures();
+
+    trace_writer::instance().stop();
+
+    profile_dump("process_profile.csv");
+
+    std::printf("%s %dx%d, %u entities (mix %u:%u:%u), %u Hz, vsync %s, seed %u\n",
+                options.headless ? "headless" : "windowed", options.width, options.height, options.entities,
+                options.asteroid_weight, options.enemy_weight, options.bullet_weight, options.tick_rate,
+                options.vsync ? "on" : "off", options.seed);
+    std::printf("%u frames measured after %u warmup frames, peak %zu live transforms\n\n", measured_frames, options.warmup, peak_entities);
+
+    std::printf("%-10s %10s %10s %10s %10s\n", "phase (ms)", "mean", "p50", "p99", "max");
+
+    for (std::size_t column = 0; column < samples.size(); column++)
+    {
+        const char* name = column < frame_phase_count ? frame_phase_names[column] : (column == spawn_column ? "spawn" : "frame");
+
+        const phase_statistics statistics = summarize(samples[column]);
+        std::printf("%-10s %10.4f %10.4f %10.4f %10.4f\n", name, statistics.mean, statistics.p50, statistics.p99, statistics.max);
+    }
+
+    std::printf("\n%-10s %10s %10s %10s %10s %10s\n", "pool", "active", "parked", "high water", "created", "reused");
+
+    for (std::size_t prefab = 0; prefab < pooled_prefab_count; prefab++)
+    {
+        const prefab_pool_stats& stats = pool_stats[prefab];
+        std::printf("%-10s %10u %10u %10u %10llu %10llu\n", pooled_prefab_names[prefab], stats.active, stats.parked, stats.high_water,
+                    static_cast<unsigned long long>(stats.created), static_cast<unsigned long long>(stats.reused));
+    }
+
+    if (!ASTEROIDS_TRACK_ALLOCATIONS || measured_frames == 0)
+        return 0;
+
+    return report_allocations(options, frame_allocations, zones_at_start);
+}
@@ -0,0 +1,249 @@
+#include <raylib.h>
+
+#include <chrono>
+#include <components/asteroid.hpp>
+#include <components/base.hpp>
+#include <components/physics.hpp>
+#include <components/player.hpp>
+#include <components/render.hpp>
+#include <cstdio>
+#include <entt/entt.hpp>
+#include <math.hpp>
+#include <platform/null_platform.hpp>
+#include <teams.hpp>
+#include <utils/texture_cache.hpp>
+#include <vector>
+
+// INFO: Compares view and group iteration over the component sets the game walks every tick,
+// using the real spawn functions so every entity carries the same mix of components as in game.
+// Both layouts are written out here instead of going through component_sets.hpp, so a single
+// binary measures both regardless of ASTEROIDS_USE_GROUPS.
+
+static Vector2 random_position()
+{
+    return Vector2{static_cast<float>(get_platform().random_value(0, 1600)), static_cast<float>(get_platform().random_value(0, 900))};
+}
+
+static Vector2 random_velocity()
+{
+    return Vector2{static_cast<float>(get_platform().random_value(-200, 200)), static_cast<float>(get_platform().random_value(-200, 200))};
+}
+
+// INFO: Late game mix, out of every 20 spawns: 8 asteroids, 7 bullets, 2 explosions, 1 smoke
+// puff and 2 background stars
+static void spawn_mix(entt::registry& registry, std::size_t index)
+{
+    switch (index % 20)
+    {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+        case 4:
+        case 5:
+        case 6:
+        case 7:
+            spawn_asteroid(registry, random_position(), random_velocity(), get_platform().random_value(0, 2));
+            break;
+        case 8:
+        case 9:
+        case 10:
+        case 11:
+        case 12:
+        case 13:
+        case 14:
+            spawn_bullet(registry, random_position(), random_velocity(), index % 2 == 0 ? team::PLAYER : team::ENEMY);
+            break;
+        case 15:
+        case 16:
+            spawn_explosion(registry, random_position(), 2.0f);
+            break;
+        case 17:
+            spawn_smoke_explosion(registry, random_position(), get_platform().random_value(0, 10), 20.0f, 1.0f);
+            break;
+        default:
+            spawn_star(registry, random_position(), static_cast<float>(get_platform().random_value(0, 360)));
+            break;
+    }
+}
+
+static void populate(entt::registry& registry, std::size_t count)
+{
+    get_platform().set_random_seed(1234);
+
+    // NOTE: Nothing is drawn, the null platform hands out empty texture handles
+    load_game_texture(GAME_TEXTURES::MAINTEXTURE);
+    load_game_texture(GAME_TEXTURES::PLANETEXTURE);
+    load_game_texture(GAME_TEXTURES::SMOKETEXTURE);
+    load_game_texture(GAME_TEXTURES::BULLETTEXTURE_BLUE);
+    load_game_texture(GAME_TEXTURES::BULLETTEXTURE_RED);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        spawn_mix(registry, i);
+    }
+
+    // INFO: Churn like a running game does, a quarter of everything dies and gets replaced
+    std::vector<entt::entity> doomed;
+
+    for (int round = 0; round < 4; round++)
+    {
+        doomed.clear();
+
+        for (auto entity : registry.view<transform>())
+        {
+            if (get_platform().random_value(0, 3) == 0)
+                doomed.push_back(entity);
+        }
+
+        registry.destroy(doomed.begin(), doomed.end());
+
+        for (std::size_t i = 0; i < doomed.size(); i++)
+        {
+            spawn_mix(registry, i);
+        }
+    }
+}
+
+struct iteration_result
+{
+    std::size_t entities;
+    double seconds;
+    float checksum;
+};
+
+template<typename Func>
+static iteration_result measure(int passes, Func func)
+{
+    iteration_result result = {0, 0.0, 0.0f};
+
+    // INFO: One warm up pass so both layouts start with hot caches
+    func(result);
+
+    result = {0, 0.0, 0.0f};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < passes; pass++)
+    {
+        func(result);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+// INFO: Same work as physics_process, boundary_process and the rest of the body passes
+static void step_bodies_view(entt::registry& registry, iteration_result& result)
+{
+    for (auto [entity, transform_data, physics_data] : registry.view<transform, physics>().each())
+    {
+        transform_data.position = transform_data.position + physics_data.velocity * 0.016f;
+        result.checksum += transform_data.position.x;
+        result.entities++;
+    }
+}
+
+static void step_bodies_group(entt::registry& registry, iteration_result& result)
+{
+    for (auto [entity, transform_data, physics_data] : registry.group<transform, physics>().each())
+    {
+        transform_data.position = transform_data.position + physics_data.velocity * 0.016f;
+        result.checksum += transform_data.position.x;
+        result.entities++;
+    }
+}
+
+// INFO: Same reads as collision_process gathering its proxies
+static void gather_colliders_view(entt::registry& registry, iteration_result& result)
+{
+    for (auto [entity, transform_data, collision_data, filter_data] : registry.view<transform, circle_collider, collision_filter>().each())
+    {
+        result.checksum += transform_data.position.y + collision_data.radius + static_cast<float>(filter_data.layer & 1u);
+        result.entities++;
+    }
+}
+
+static void gather_colliders_group(entt::registry& registry, iteration_result& result)
+{
+    for (auto [entity, collision_data, filter_data, transform_data] : registry.group<circle_collider, collision_filter>(entt::get<transform>).each())
+    {
+        result.checksum += transform_data.position.y + collision_data.radius + static_cast<float>(filter_data.layer & 1u);
+        result.entities++;
+    }
+}
+
+// INFO: Same reads as sprite_render_process building its draw calls
+static void submit_sprites_view(entt::registry& registry, iteration_result& result)
+{
+    for (auto [entity, transform_data, render_data] : registry.view<transform, sprite_render>().each())
+    {
+        result.checksum += transform_data.rotation + render_data.source.width * render_data.scale;
+        result.entities++;
+    }
+}
+
+static void submit_sprites_group(entt::registry& registry, iteration_result& result)
+{
+    for (auto [entity, render_data, transform_data] : registry.group<sprite_render>(entt::get<transform>).each())
+    {
+        result.checksum += transform_data.rotation + render_data.source.width * render_data.scale;
+        result.entities++;
+    }
+}
+
+static void report(const char* set, std::size_t count, const iteration_result& view_result, const iteration_result& group_result)
+{
+    const double view_ns  = view_result.seconds * 1e9 / view_result.entities;
+    const double group_ns = group_result.seconds * 1e9 / group_result.entities;
+
+    std::printf("%10zu %-12s %14.2f %14.2f %8.2fx\n", count, set, view_ns, group_ns, view_ns / group_ns);
+
+    if (view_result.entities != group_result.entities)
+    {
+        std::printf("    mismatch, view visited %zu entities and group %zu\n", view_result.entities, group_result.entities);
+    }
+}
+
+int main()
+{
+    null_platform headless;
+    set_platform(&headless);
+
+    const std::size_t counts[] = {1000, 10000, 100000};
+
+    std::printf("%10s %-12s %14s %14s %8s\n", "spawns", "set", "view (ns/e)", "group (ns/e)", "speedup");
+
+    for (auto count : counts)
+    {
+        const int passes = static_cast<int>(20000000 / count);
+
+        entt::registry view_registry;
+        populate(view_registry, count);
+
+        // INFO: Groups are declared up front, the same way the game ends up after its first tick
+        entt::registry group_registry;
+        group_registry.group<transform, physics>();
+        group_registry.group<circle_collider, collision_filter>(entt::get<transform>);
+        group_registry.group<sprite_render>(entt::get<transform>);
+        populate(group_registry, count);
+
+        report("bodies", count,
+               measure(passes, [&view_registry](iteration_result& result) { step_bodies_view(view_registry, result); }),
+               measure(passes, [&group_registry](iteration_result& result) { step_bodies_group(group_registry, result); }));
+
+        report("colliders", count,
+               measure(passes, [&view_registry](iteration_result& result) { gather_colliders_view(view_registry, result); }),
+               measure(passes, [&group_registry](iteration_result& result) { gather_colliders_group(group_registry, result); }));
+
+        report("sprites", count,
+               measure(passes, [&view_registry](iteration_result& result) { submit_sprites_view(view_registry, result); }),
+               measure(passes, [&group_registry](iteration_result& result) { submit_sprites_group(group_registry, result); }));
+    }
+
+    unload_game_textures();
+
+    return 0;
+}
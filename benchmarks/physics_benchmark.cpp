@@ -0,0 +1,101 @@
+#include <raylib.h>
+
+#include <chrono>
+#include <components/base.hpp>
+#include <cstdio>
+#include <entt/entt.hpp>
+#include <math.hpp>
+#include <processors/physics_processors.hpp>
+#include <random>
+
+// INFO: The per entity view loop physics_process used before the batched integrator
+struct view_physics_process : entt::process<view_physics_process, float>
+{
+    using delta_type = float;
+
+    view_physics_process(entt::registry& registry) :
+        registry(registry) {}
+
+    void update(delta_type delta_time, void*)
+    {
+        auto physics_view = registry.view<transform, physics>();
+        for (auto [entity, transform_data, physics_data] : physics_view.each())
+        {
+            physics_data.velocity = physics_data.velocity + physics_data.external_impulse * delta_time;
+            if (physics_data.drag > 0.0f)
+            {
+                physics_data.velocity = physics_data.velocity * (1.0f - physics_data.drag);
+            }
+
+            transform_data.position = transform_data.position + physics_data.velocity * delta_time;
+            transform_data.rotation = transform_data.rotation + physics_data.angular_velocity * delta_time;
+
+            physics_data.external_impulse = Vector2{0, 0};
+        }
+    }
+
+   protected:
+    entt::registry& registry;
+};
+
+static void populate(entt::registry& registry, std::size_t count)
+{
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(0.0f, 900.0f);
+    std::uniform_real_distribution<float> velocity(-200.0f, 200.0f);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        auto entity = registry.create();
+
+        // INFO: Same mix as the game, ships have drag and everything else drifts
+        float drag = i % 8 == 0 ? 0.005f : 0.0f;
+
+        registry.emplace<transform>(entity, transform{Vector2{position(generator), position(generator)}, 0.0f});
+        registry.emplace<physics>(entity, physics{Vector2{velocity(generator), velocity(generator)}, 15.0f, drag, Vector2{0, 0}, Vector2{0, 0}});
+    }
+}
+
+template<typename Process>
+static double run(std::size_t count, int ticks)
+{
+    entt::registry registry;
+    populate(registry, count);
+
+    Process process(registry);
+
+    // INFO: The first tick only initializes the process
+    process.tick(1.0f / 60.0f);
+    process.tick(1.0f / 60.0f);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        process.tick(1.0f / 60.0f);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(count) * ticks / seconds;
+}
+
+int main()
+{
+    const std::size_t counts[] = {10000, 100000, 1000000};
+
+    std::printf("%10s %18s %18s %8s\n", "bodies", "view (bodies/s)", "batched (bodies/s)", "speedup");
+
+    for (auto count : counts)
+    {
+        const int ticks = static_cast<int>(20000000 / count);
+
+        double view_throughput    = run<view_physics_process>(count, ticks);
+        double batched_throughput = run<physics_process>(count, ticks);
+
+        std::printf("%10zu %18.3e %18.3e %7.2fx\n", count, view_throughput, batched_throughput, batched_throughput / view_throughput);
+    }
+
+    return 0;
+}
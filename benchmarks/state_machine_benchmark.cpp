@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utils/state.hpp>
+#include <utils/static_state_machine.hpp>
+#include <vector>
+
+// INFO: Runs the same two state chase and attack behaviour on many agents, once through the
+// shared_ptr and std::function state_machine and once through static_state_machine. Both
+// versions must fire the same number of shots, the checksum line shows they agree.
+
+static const float attack_radius   = 200.0f;
+static const float attack_interval = 0.65f;
+static const float chase_speed     = 120.0f;
+static const float knockback       = 150.0f;
+
+struct agent
+{
+    float distance;
+    std::uint32_t shots;
+};
+
+// INFO: The shared_ptr version needs states per agent, each one capturing the agent it drives
+static state_machine make_dynamic_machine(agent& agent_data)
+{
+    std::shared_ptr<float> attack_elapsed = std::make_shared<float>(0.0f);
+
+    auto on_chasing_update = [&agent_data](float delta_time) {
+        agent_data.distance -= chase_speed * delta_time;
+    };
+
+    auto on_attack_enter = [attack_elapsed]() {
+        *attack_elapsed = 0.0f;
+    };
+
+    auto on_attack_update = [&agent_data, attack_elapsed](float delta_time) {
+        *attack_elapsed += delta_time;
+
+        if (*attack_elapsed <= attack_interval)
+            return;
+
+        *attack_elapsed = 0.0f;
+        agent_data.shots++;
+        agent_data.distance += knockback;
+    };
+
+    std::shared_ptr<state> chasing_state = std::make_shared<state>(nullptr, nullptr, on_chasing_update);
+    std::shared_ptr<state> attack_state  = std::make_shared<state>(on_attack_enter, nullptr, on_attack_update);
+
+    chasing_state->add_transition([&agent_data]() { return agent_data.distance < attack_radius; }, attack_state, "TO ATTACK");
+    attack_state->add_transition([&agent_data]() { return agent_data.distance >= attack_radius; }, chasing_state, "TO CHASING");
+
+    return state_machine(chasing_state);
+}
+
+struct chasing
+{
+    void update(agent& agent_data, float delta_time) { agent_data.distance -= chase_speed * delta_time; }
+};
+
+struct attacking
+{
+    float elapsed = 0.0f;
+
+    void update(agent& agent_data, float delta_time)
+    {
+        elapsed += delta_time;
+
+        if (elapsed <= attack_interval)
+            return;
+
+        elapsed = 0.0f;
+        agent_data.shots++;
+        agent_data.distance += knockback;
+    }
+};
+
+struct in_range
+{
+    bool operator()(agent& agent_data) const { return agent_data.distance < attack_radius; }
+};
+
+struct out_of_range
+{
+    bool operator()(agent& agent_data) const { return agent_data.distance >= attack_radius; }
+};
+
+using static_machine = static_state_machine<agent, state_list<chasing, attacking>,
+                                            transition_list<transition<chasing, attacking, in_range>, transition<attacking, chasing, out_of_range>>>;
+
+static std::vector<agent> make_agents(std::uint32_t count)
+{
+    std::vector<agent> agents(count);
+
+    // INFO: Spread out so the agents change state on different ticks
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        agents[i] = agent{attack_radius + static_cast<float>(i % 400), 0};
+    }
+
+    return agents;
+}
+
+static std::uint64_t count_shots(const std::vector<agent>& agents)
+{
+    std::uint64_t shots = 0;
+
+    for (const agent& agent_data : agents)
+    {
+        shots += agent_data.shots;
+    }
+
+    return shots;
+}
+
+// INFO: Usage: state_machine_benchmark [agents] [ticks]
+int main(int argc, char** argv)
+{
+    const std::uint32_t agent_count = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10000;
+    const std::uint32_t ticks       = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 600;
+    const float delta_time          = 1.0f / 60.0f;
+
+    state::log_transitions = false;
+
+    std::vector<agent> dynamic_agents = make_agents(agent_count);
+    std::vector<agent> static_agents  = make_agents(agent_count);
+
+    std::vector<state_machine> dynamic_machines;
+    dynamic_machines.reserve(agent_count);
+
+    for (agent& agent_data : dynamic_agents)
+    {
+        dynamic_machines.push_back(make_dynamic_machine(agent_data));
+    }
+
+    std::vector<static_machine> static_machines(agent_count);
+
+    auto dynamic_start = std::chrono::steady_clock::now();
+
+    for (std::uint32_t tick = 0; tick < ticks; tick++)
+    {
+        for (state_machine& machine : dynamic_machines)
+        {
+            machine.update(delta_time);
+        }
+    }
+
+    auto dynamic_end = std::chrono::steady_clock::now();
+
+    for (std::uint32_t tick = 0; tick < ticks; tick++)
+    {
+        for (std::uint32_t i = 0; i < agent_count; i++)
+        {
+            static_machines[i].update(static_agents[i], delta_time);
+        }
+    }
+
+    auto static_end = std::chrono::steady_clock::now();
+
+    const double updates    = static_cast<double>(agent_count) * ticks;
+    const double dynamic_ns = std::chrono::duration<double, std::nano>(dynamic_end - dynamic_start).count() / updates;
+    const double static_ns  = std::chrono::duration<double, std::nano>(static_end - dynamic_end).count() / updates;
+
+    std::printf("%u agents, %u ticks\n\n", agent_count, ticks);
+    std::printf("%-22s %12s %14s\n", "machine", "ns/update", "bytes/agent");
+    std::printf("%-22s %12.2f %14s\n", "state_machine", dynamic_ns, "heap");
+    std::printf("%-22s %12.2f %14zu\n", "static_state_machine", static_ns, sizeof(static_machine));
+    std::printf("\nspeedup %.1fx, shots %llu / %llu\n", dynamic_ns / static_ns, static_cast<unsigned long long>(count_shots(dynamic_agents)),
+                static_cast<unsigned long long>(count_shots(static_agents)));
+
+    return count_shots(dynamic_agents) == count_shots(static_agents) ? 0 : 1;
+}
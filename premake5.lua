@@ -3,6 +3,59 @@ workspace "slo-jam"
 
 local raylib_dir = 'raylib/src'
 
+newoption {
+	trigger = "no-groups",
+	description = "Iterate the hot component sets through views instead of entt groups"
+}
+
+newoption {
+	trigger = "profiling",
+	description = "Time every scheduler process, F3 shows the last frame and process_profile.csv is written on exit"
+}
+
+newoption {
+	trigger = "track-allocations",
+	description = "Count heap allocations per process and frame phase, game_benchmark --allocation-budget checks them"
+}
+
+-- INFO: Simulation core, everything but the entry point. Talks to the outside world through
+-- the platform interface, so it runs with a window or headless on the null platform.
+project "asteroids_core"
+	kind "StaticLib"
+	language "C++"
+	cppdialect "C++17"
+
+	location "asteroids/"
+
+	targetdir "bin/%{prj.name}/%{cfg.buildcfg}"
+	objdir "obj/%{prj.name}/%{cfg.buildcfg}"
+	targetname "asteroids_core"
+
+	includedirs { "%{prj.location}/include" }
+
+	includedirs { "%{wks.location}/libs/raylib/include/" }
+
+	files { "%{prj.location}/include/**.h", "%{prj.location}/include/**.hpp", "%{prj.location}/src/**.cpp" }
+
+	filter "options:no-groups"
+		defines { "ASTEROIDS_USE_GROUPS=0" }
+
+	filter "options:profiling"
+		defines { "ASTEROIDS_PROFILING=1" }
+
+	filter "options:track-allocations"
+		defines { "ASTEROIDS_TRACK_ALLOCATIONS=1" }
+
+	filter "configurations:debug"
+		defines { "DEBUG" }
+		symbols "On"
+
+	filter "configurations:release"
+		defines { "NDEBUG" }
+		optimize "On"
+
+	filter {}
+
 project "asteroids"
 	kind "ConsoleApp"
 	language "C++"
@@ -19,18 +72,128 @@ project "asteroids"
 	includedirs { "%{wks.location}/libs/raylib/include/" }
 	libdirs { "%{wks.location}/libs/raylib/" }
 
-	links { "raylib" }
+	links { "asteroids_core", "raylib" }
 
 	filter "system:windows"
 		links { "OpenGL32", "GDI32", "WinMM"}
+	filter "system:linux"
+		links { "pthread" }
 	filter {}
 
-	files { "%{prj.location}/**.h", "%{prj.location}/**.hpp", "%{prj.location}/**.cpp" }
+	files { "%{prj.location}/main.cpp" }
+
+	-- INFO: An archive that no longer matches its PNGs would ship stale pixels, the build stops
+	-- until asset_packer runs again
+	dependson { "asset_packer" }
 
 	prebuildcommands {
+		"{CHDIR} %{prj.location} && %{wks.location}/bin/asset_packer/%{cfg.buildcfg}/asset_packer --check",
 		"{COPYDIR} %{prj.location}/resources/ %{wks.location}/bin/%{prj.name}/%{cfg.buildcfg}/resources/",
 	}
 	
+	filter "options:no-groups"
+		defines { "ASTEROIDS_USE_GROUPS=0" }
+
+	filter "options:profiling"
+		defines { "ASTEROIDS_PROFILING=1" }
+
+	filter "options:track-allocations"
+		defines { "ASTEROIDS_TRACK_ALLOCATIONS=1" }
+
+	filter "configurations:debug"
+		defines { "DEBUG" }
+		symbols "On"
+
+	filter "configurations:release"
+		defines { "NDEBUG" }
+		optimize "On"
+
+	filter {}
+
+-- INFO: Standalone benchmarks, each one is a single source file in benchmarks/
+local benchmarks = { "physics_benchmark", "iteration_benchmark", "game_benchmark", "state_machine_benchmark", "asset_benchmark" }
+
+for _, benchmark in ipairs(benchmarks) do
+project(benchmark)
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	location "benchmarks/"
+
+	targetdir "bin/%{prj.name}/%{cfg.buildcfg}"
+	objdir "obj/%{prj.name}/%{cfg.buildcfg}"
+	targetname(benchmark)
+
+	includedirs { "%{wks.location}/asteroids/include" }
+
+	includedirs { "%{wks.location}/libs/raylib/include/" }
+	libdirs { "%{wks.location}/libs/raylib/" }
+
+	links { "asteroids_core", "raylib" }
+
+	filter "system:windows"
+		links { "OpenGL32", "GDI32", "WinMM"}
+	filter "system:linux"
+		links { "pthread" }
+	filter {}
+
+	files { "%{prj.location}/" .. benchmark .. ".cpp" }
+
+	prebuildcommands {
+		"{COPYDIR} %{wks.location}/asteroids/resources/ %{wks.location}/bin/%{prj.name}/%{cfg.buildcfg}/resources/",
+	}
+
+	filter "options:no-groups"
+		defines { "ASTEROIDS_USE_GROUPS=0" }
+
+	filter "options:profiling"
+		defines { "ASTEROIDS_PROFILING=1" }
+
+	filter "options:track-allocations"
+		defines { "ASTEROIDS_TRACK_ALLOCATIONS=1" }
+
+	filter "configurations:debug"
+		defines { "DEBUG" }
+		symbols "On"
+
+	filter "configurations:release"
+		defines { "NDEBUG" }
+		optimize "On"
+
+	filter {}
+end
+
+-- INFO: Offline tools, asset_packer writes the texture archive the game maps on startup
+project "asset_packer"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	location "tools/"
+
+	targetdir "bin/%{prj.name}/%{cfg.buildcfg}"
+	objdir "obj/%{prj.name}/%{cfg.buildcfg}"
+	targetname "asset_packer"
+
+	includedirs { "%{wks.location}/asteroids/include" }
+
+	includedirs { "%{wks.location}/libs/raylib/include/" }
+	libdirs { "%{wks.location}/libs/raylib/" }
+
+	links { "asteroids_core", "raylib" }
+
+	filter "system:windows"
+		links { "OpenGL32", "GDI32", "WinMM"}
+	filter "system:linux"
+		links { "pthread" }
+	filter {}
+
+	files { "%{prj.location}/asset_packer.cpp" }
+
+	-- INFO: Run from asteroids/ so the archive lands next to the PNGs and ships with them
+	debugdir "%{wks.location}/asteroids"
+
 	filter "configurations:debug"
 		defines { "DEBUG" }
 		symbols "On"
@@ -0,0 +1,259 @@
+#include <raylib.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <utils/asset_archive.hpp>
+#include <utils/texture_cache.hpp>
+#include <utility>
+#include <vector>
+
+// INFO: Offline step that decodes every game texture once and writes them to a single archive
+// of RGBA8 pixels, which the game maps instead of decoding the PNGs on every start. Run it from
+// the asteroids directory, next to resources/.
+
+struct packer_options
+{
+    const char* output_path = game_archive_path;
+
+    // INFO: Deflates the pixels, smaller on disk but uploading then needs a decompressed copy
+    bool compress = false;
+
+    // INFO: Only compares the archive against the PNGs, the build runs it before shipping one
+    bool check = false;
+};
+
+static void print_usage(const char* program)
+{
+    std::printf("usage: %s [options]\n", program);
+    std::printf("  --output <file>      archive to write (%s)\n", game_archive_path);
+    std::printf("  --compress           deflate the pixels of every texture it makes smaller\n");
+    std::printf("  --check              fail when the archive no longer matches the PNGs, writes nothing\n");
+}
+
+static bool parse_options(int argc, char** argv, packer_options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const char* value    = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(argument, "--compress") == 0)
+            options.compress = true;
+        else if (std::strcmp(argument, "--check") == 0)
+            options.check = true;
+        else if (value == nullptr)
+            return false;
+        else if (std::strcmp(argument, "--output") == 0)
+            options.output_path = argv[++i];
+        else
+            return false;
+    }
+
+    return true;
+}
+
+// INFO: Size and FNV-1a hash of a PNG, false when it is missing
+static bool hash_source(const char* path, std::uint64_t& size, std::uint64_t& hash)
+{
+    mapped_file source;
+
+    if (!source.open(path))
+        return false;
+
+    hash = 14695981039346656037ull;
+
+    for (std::size_t i = 0; i < source.size(); i++)
+    {
+        hash = (hash ^ source.data()[i]) * 1099511628211ull;
+    }
+
+    size = source.size();
+
+    return true;
+}
+
+struct packed_texture
+{
+    asset_archive_entry entry;
+    std::vector<unsigned char> pixels;
+};
+
+static bool pack_texture(GAME_TEXTURES texture_id, bool compress, packed_texture& packed)
+{
+    const char* path = game_texture_path(texture_id);
+    Image image      = LoadImage(path);
+
+    if (image.data == nullptr)
+    {
+        std::fprintf(stderr, "could not decode %s\n", path);
+        return false;
+    }
+
+    // NOTE: Paletted and RGB sheets are widened, the game uploads everything as RGBA8
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    const int pixel_bytes             = image.width * image.height * 4;
+    const unsigned char* image_pixels = static_cast<const unsigned char*>(image.data);
+
+    packed.entry = asset_archive_entry{static_cast<std::uint32_t>(texture_id),
+                                       static_cast<std::uint32_t>(image.width),
+                                       static_cast<std::uint32_t>(image.height),
+                                       0,
+                                       0,
+                                       static_cast<std::uint64_t>(pixel_bytes),
+                                       static_cast<std::uint64_t>(pixel_bytes),
+                                       0,
+                                       0};
+
+    // INFO: Lets --check notice when the PNG is edited after packing
+    hash_source(path, packed.entry.source_size, packed.entry.source_hash);
+
+    packed.pixels.assign(image_pixels, image_pixels + pixel_bytes);
+
+    if (compress)
+    {
+        int compressed_size             = 0;
+        unsigned char* compressed_bytes = CompressData(image_pixels, pixel_bytes, &compressed_size);
+
+        // INFO: Stored as is when deflating does not pay off
+        if (compressed_bytes != nullptr && compressed_size < pixel_bytes)
+        {
+            packed.entry.flags |= ASSET_COMPRESSED;
+            packed.entry.size = static_cast<std::uint64_t>(compressed_size);
+            packed.pixels.assign(compressed_bytes, compressed_bytes + compressed_size);
+        }
+
+        MemFree(compressed_bytes);
+    }
+
+    UnloadImage(image);
+
+    std::printf("%-40s %5ux%-5u %10llu bytes%s\n", path, packed.entry.width, packed.entry.height,
+                static_cast<unsigned long long>(packed.entry.size), (packed.entry.flags & ASSET_COMPRESSED) != 0 ? " deflated" : "");
+
+    return true;
+}
+
+static bool write_archive(const char* path, std::vector<packed_texture>& textures)
+{
+    const asset_archive_header header = {{asset_archive_magic[0], asset_archive_magic[1], asset_archive_magic[2], asset_archive_magic[3]},
+                                         asset_archive_version,
+                                         static_cast<std::uint32_t>(textures.size()),
+                                         0};
+
+    // INFO: Pixels follow the table, each starting on the next aligned offset
+    std::uint64_t offset = sizeof(header) + textures.size() * sizeof(asset_archive_entry);
+
+    for (packed_texture& texture : textures)
+    {
+        offset               = (offset + asset_archive_align - 1) / asset_archive_align * asset_archive_align;
+        texture.entry.offset = offset;
+        offset += texture.entry.size;
+    }
+
+    std::FILE* file = std::fopen(path, "wb");
+
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "could not open %s for writing\n", path);
+        return false;
+    }
+
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    for (const packed_texture& texture : textures)
+    {
+        std::fwrite(&texture.entry, sizeof(texture.entry), 1, file);
+    }
+
+    const unsigned char padding[asset_archive_align] = {};
+
+    for (const packed_texture& texture : textures)
+    {
+        const long position = std::ftell(file);
+        std::fwrite(padding, 1, static_cast<std::size_t>(texture.entry.offset - position), file);
+        std::fwrite(texture.pixels.data(), 1, texture.pixels.size(), file);
+    }
+
+    const bool written = std::ferror(file) == 0;
+    std::fclose(file);
+
+    std::printf("\n%s, %zu textures, %llu bytes\n", path, textures.size(), static_cast<unsigned long long>(offset));
+
+    return written;
+}
+
+static bool check_archive(const char* path)
+{
+    // INFO: Nothing to ship, the game loads the PNGs
+    if (!std::filesystem::exists(path))
+        return true;
+
+    asset_archive archive;
+
+    if (!archive.open(path))
+    {
+        std::fprintf(stderr, "%s was packed by another version of asset_packer, run it again\n", path);
+        return false;
+    }
+
+    bool current = true;
+
+    for (const GAME_TEXTURES texture_id : game_texture_ids)
+    {
+        const char* source_path = game_texture_path(texture_id);
+
+        std::uint64_t source_size = 0;
+        std::uint64_t source_hash = 0;
+
+        // NOTE: Without its PNG the archive is the only copy of a texture
+        if (!hash_source(source_path, source_size, source_hash))
+            continue;
+
+        const asset_archive_entry* entry = archive.find(texture_id);
+
+        if (entry != nullptr && entry->source_size == source_size && entry->source_hash == source_hash)
+            continue;
+
+        std::fprintf(stderr, "%s changed since %s was packed\n", source_path, path);
+        current = false;
+    }
+
+    if (!current)
+        std::fprintf(stderr, "run asset_packer to pack it again\n");
+
+    return current;
+}
+
+// INFO: Usage: asset_packer [--compress] [--check] [--output resources/textures.pak]
+int main(int argc, char** argv)
+{
+    packer_options options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (options.check)
+        return check_archive(options.output_path) ? 0 : 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::vector<packed_texture> textures;
+
+    for (const GAME_TEXTURES texture_id : game_texture_ids)
+    {
+        packed_texture packed;
+
+        if (!pack_texture(texture_id, options.compress, packed))
+            return 1;
+
+        textures.push_back(std::move(packed));
+    }
+
+    return write_archive(options.output_path, textures) ? 0 : 1;
+}